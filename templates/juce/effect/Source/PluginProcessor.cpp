@@ -84,7 +84,8 @@ bool KlangEffectAudioProcessor::isMidiEffect() const
 
 double KlangEffectAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // KLANG : report the plugin's tail (e.g. declared, or measured by its silence detector)
+    return pingpong.tail();
 }
 
 int KlangEffectAudioProcessor::getNumPrograms()
@@ -114,8 +115,8 @@ void KlangEffectAudioProcessor::changeProgramName (int index, const juce::String
 //==============================================================================
 void KlangEffectAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
+    // KLANG : set the sample rate and maximum block size (before playback; allocates)
+    pingpong.configure((float)sampleRate, samplesPerBlock);
 }
 
 void KlangEffectAudioProcessor::releaseResources()
@@ -13,12 +13,18 @@
 #include <algorithm>
 #include <type_traits>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#ifndef __wasm__
+#include <thread>
+#include <condition_variable>
+#endif
 #include <functional>
 
 #include <float.h>
 
 #ifdef __wasm__
-#define THREAD_LOCAL 
+#define THREAD_LOCAL // single-threaded (Workers runs all jobs on the caller)
 static inline float _sqrt(float x) { return __builtin_sqrtf(x); }
 static inline float _abs(float x) { return __builtin_fabsf(x); }
 #define SQRT _sqrt
@@ -27,7 +33,7 @@ static inline float _abs(float x) { return __builtin_fabsf(x); }
 #define FABS _abs
 #endif
 #ifdef __APPLE__
-#define THREAD_LOCAL
+#define THREAD_LOCAL thread_local // per-thread state for the worker pool (Xcode 8+)
 #define SQRT ::sqrt
 #define SQRTF ::sqrtf
 #define ABS ::abs
@@ -53,6 +59,34 @@ static inline float _abs(float x) { return __builtin_fabsf(x); }
 
 #define GRAPH_SERIES 4
 
+// scratch block size for block-based (stereo) processing
+#ifndef KLANG_BLOCK_SIZE
+#define KLANG_BLOCK_SIZE 64
+#endif
+
+// SIMD support for multi-channel signals (SSE/AVX or AArch64 NEON; scalar fallback otherwise)
+#if !defined(KLANG_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#define KLANG_SSE 1
+#include <immintrin.h>
+#if defined(__AVX__)
+#define KLANG_AVX 1
+#endif
+#if defined(__AVX512F__)
+#define KLANG_AVX512 1
+#endif
+#elif !defined(KLANG_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#define KLANG_NEON 1
+#include <arm_neon.h>
+#endif
+
+// floating-point control register access (see NoDenormals)
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define KLANG_MXCSR 1
+#include <xmmintrin.h>
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+#define KLANG_FPCR 1
+#endif
+
 // provide access to original math functions through std:: prefix
 namespace std {
 	namespace klang {
@@ -82,7 +116,7 @@ namespace klang {
 		}
 		bool below(unsigned char M, unsigned char m, unsigned char b) const { return !atLeast(M, m, b); }
 	}
-	static constexpr version = { 0, 7, 2, KLANG_DEBUG };
+	static constexpr version = { 0, 7, 8, KLANG_DEBUG };
 
 	/// Klang mode identifiers (e.g. averages, level following)
 	enum Mode { Peak, RMS, Mean };
@@ -232,12 +266,152 @@ namespace klang {
 	/// The square root of 2 (and it's inverse).
 	constexpr constant root2 = { 1.4142135623730950488016887242097 };
 
+	/// Pseudo-random number generator (xorshift; per object, seedable and repeatable)
+	struct Random {
+		/// New generator (default: the next stream, numbered per plugin and per voice; see number())
+		Random() { seed(stream++); }
+		Random(unsigned int seed) { Random::seed(seed); }
+
+		/// Restart the stream(s) from seed
+		void seed(unsigned int seed) {
+			state = hash(seed);
+			for (int l = 0; l < 16; l++)
+				lanes[l] = hash(seed * 16 + l + 0x9E3779B9u);
+			uniforms = normals = 16;
+		}
+
+		/// Number the streams of default-constructed generators from first (per thread; returns the previous next stream)
+		/// Plugins restart at 1 and Notes::add numbers each voice, so seeds don't depend on other instances.
+		static unsigned int number(unsigned int first) {
+			const unsigned int previous = stream;
+			stream = first;
+			return previous;
+		}
+
+		/// Generator used by random() on this thread (nullptr: the default; see Scope)
+		THREAD_LOCAL inline static Random* current = nullptr;
+
+		/// Use generator for random() on this thread (while in scope; e.g. a voice's own stream)
+		struct Scope {
+			Random* previous;
+			Scope(Random& generator) : previous(current) { current = &generator; }
+			~Scope() { current = previous; }
+		};
+
+		/// Next 32 random bits
+		unsigned int next() {
+			unsigned int x = state;
+			x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+			return state = x;
+		}
+
+		/// Uniform in [0, 1)
+		float uniform() { return float(next() >> 8) * (1.f / 16777216.f); }
+		/// Uniform in [min, max)
+		float uniform(float min, float max) { return uniform() * (max - min) + min; }
+		/// Uniform in [-1, 1)
+		float bipolar() { return uniform() * 2.f - 1.f; }
+		/// Approximately normal (mean 0, variance 1; sum of four uniforms)
+		float gaussian() { return (uniform() + uniform() + uniform() + uniform() - 2.f) * 1.7320508f; }
+
+		/// Fill a block with uniform values in [min, max) (16 independent lanes; same stream for any block sizes)
+		void uniform(float* output, int length, float min = 0.f, float max = 1.f) {
+			const float scale = max - min, offset = min - scale;
+			for (int s = 0; s < length;) {
+				if (uniforms == 16) {
+					fill(uniform16);
+					uniforms = 0;
+				}
+				const int n = length - s < 16 - uniforms ? length - s : 16 - uniforms;
+				for (int l = 0; l < n; l++)
+					output[s + l] = uniform16[uniforms + l] * scale + offset;
+				uniforms += n;
+				s += n;
+			}
+		}
+
+		/// Fill a block with uniform values in [-1, 1)
+		void bipolar(float* output, int length) { uniform(output, length, -1.f, 1.f); }
+
+		/// Next value of the block stream, uniform in [min, max) (per sample; continues the same lanes as uniform(output, length))
+		float draw(float min = 0.f, float max = 1.f) {
+			if (uniforms == 16) {
+				fill(uniform16);
+				uniforms = 0;
+			}
+			const float scale = max - min;
+			return uniform16[uniforms++] * scale + (min - scale);
+		}
+
+		/// Fill a block with approximately normal values (mean 0, variance 1; same stream for any block sizes)
+		void gaussian(float* output, int length) {
+			for (int s = 0; s < length;) {
+				if (normals == 16) {
+					float block[16];
+					for (int l = 0; l < 16; l++)
+						normal16[l] = 0.f;
+					for (int i = 0; i < 4; i++) {
+						fill(block);
+						for (int l = 0; l < 16; l++)
+							normal16[l] += block[l];
+					}
+					for (int l = 0; l < 16; l++)
+						normal16[l] = (normal16[l] - 6.f) * 1.7320508f;
+					normals = 0;
+				}
+				const int n = length - s < 16 - normals ? length - s : 16 - normals;
+				for (int l = 0; l < n; l++)
+					output[s + l] = normal16[normals + l];
+				normals += n;
+				s += n;
+			}
+		}
+
+	protected:
+		unsigned int state;
+		unsigned int lanes[16];
+		float uniform16[16], normal16[16];	// last block fills (in [1, 2) / normal)
+		int uniforms = 16, normals = 16;	// values used from each
+
+		// 16 values in [1, 2) (one step of each lane; vectorises)
+		void fill(float* block) {
+			unsigned int bits[16];
+			for (int l = 0; l < 16; l++) {
+				unsigned int x = lanes[l];
+				x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+				lanes[l] = x;
+				bits[l] = (x >> 9) | 0x3F800000u;
+			}
+			memcpy(block, bits, sizeof(bits));
+		}
+
+		// well-mixed, non-zero state from a seed
+		static unsigned int hash(unsigned int x) {
+			x ^= x >> 16; x *= 0x7FEB352Du;
+			x ^= x >> 15; x *= 0x846CA68Bu;
+			x ^= x >> 16;
+			return x ? x : 0x9E3779B9u;
+		}
+
+		THREAD_LOCAL inline static unsigned int stream = 1; // next default stream
+	};
+
+	/// Default generator (for random(); per thread)
+	THREAD_LOCAL static Random prng(1);
+
 	/// Generates a random number between min and max. Use an integer types for whole numbers.
+	/// In note code, draws from the voice's own stream (repeatable, whichever thread renders it).
 	template<typename TYPE>
-	inline static TYPE random(const TYPE min, const TYPE max) { return rand() * ((max - min) / (TYPE)RAND_MAX) + min; }
+	inline static TYPE random(const TYPE min, const TYPE max) {
+		Random& generator = Random::current ? *Random::current : prng;
+		if constexpr (std::is_integral_v<TYPE>)
+			return min + TYPE(generator.next() % (unsigned int)(max - min + 1));
+		else
+			return TYPE(generator.uniform() * (max - min) + min);
+	}
 
 	/// Set the random seed (to allow repeatable random generation).
-	inline static void random(const unsigned int seed) { srand(seed); }
+	inline static void random(const unsigned int seed) { prng.seed(seed); }
 
 	/// A function that handles an event.
 	typedef void event;
@@ -321,6 +495,698 @@ namespace klang {
 		Array() = default; // Default constructor to allow empty initialization
 	};
 
+	struct Memory
+	{
+		typedef unsigned char Byte;
+		typedef Byte* Pointer;
+
+		Pointer start, ptr, end;
+		size_t size;
+		bool owned;
+
+		Memory() {
+			detach();
+		}
+
+		Memory(size_t size) {
+			create(size);
+		}
+
+		~Memory() {
+			free();
+		}
+
+		// attach to an existing buffer
+		void attach(unsigned char* data, size_t size, bool own = false) {
+			Memory::size = size;
+			start = ptr = data;
+			end = start + size;
+			owned = own;
+		}
+
+		// detach from the buffer (without freeing it)
+		void detach() {
+			start = ptr = end = nullptr;
+			size = 0;
+			owned = false;
+		}
+
+		// allocate memory
+		bool create(size_t size) {
+			free();
+			start = ptr = new Byte[size];
+			if (start) {
+				Memory::size = size;
+				end = start + size;
+				owned = true;
+				return true;
+			}
+			return false;
+		}
+
+		// clear memory
+		void clear() {
+			memset(start, 0, size);
+		}
+
+		// rewind memory to start
+		void rewind() {
+			ptr = start;
+		}
+
+		// rewind memory
+		void rewind(int bytes) {
+			ptr -= bytes;
+		}
+
+		// skip / fastforward memory
+		void skip(int bytes) {
+			ptr += bytes;
+		}
+
+		// release memory
+		void free() {
+			if (owned && start) {
+				ptr = end = nullptr;
+				delete[] start;
+				start = nullptr;
+				size = 0;
+			}
+		}
+
+		// check if pointer is at end of memory
+		bool finished() const {
+			return ptr >= end;
+		}
+
+		// return memory-mapped file pointer
+		FILE* file() {
+			FILE* f = fopen("/dev/null", "wt");
+			if (!f) f = fopen("nul", "wt");
+			setvbuf(f, (char*)start, _IOFBF, size);
+			return f;
+		}
+
+		bool load(const char* path) {
+			FILE* f = fopen(path, "rb");
+			if (!f) return false;
+
+			// find out length of file
+			fseek(f, 0, SEEK_END);
+			size_t length = ftell(f);
+			fseek(f, 0, SEEK_SET);
+
+			// allocate memory and read file
+			if (!create(length)) {
+				fclose(f);
+				return false;
+			}
+			fread(start, 1, length, f);
+			fclose(f);
+
+			return true;
+		}
+
+		// retrieve the next value from memory
+		template<typename TYPE>
+		bool get(TYPE& value) {
+			if (ptr + sizeof(TYPE) > end) {
+				ptr = end;
+				return false;
+			}
+			value = *(TYPE*)ptr;
+			ptr += sizeof(TYPE);
+			return true;
+		}
+
+		// retrieve the next value from memory
+		template<typename TYPE>
+		operator TYPE() {
+			TYPE value;
+			get(value);
+			return value;
+		}
+
+		// add a value to the memory
+		template<typename TYPE>
+		bool add(const TYPE& value) {
+			if (ptr + sizeof(TYPE) > end)
+				return false;
+			*(TYPE*)ptr = value;
+			ptr += sizeof(TYPE);
+			return true;
+		}
+
+		// add a value to the memory
+		template<typename TYPE>
+		Memory& operator+=(const TYPE& value) {
+			add(value);
+			return *this;
+		}
+
+		// check if memory is equal to a value
+		template<typename TYPE>
+		bool operator==(const TYPE& value) const {
+			if (ptr + sizeof(TYPE) > end)
+				return false;
+			return value == *(TYPE*)ptr;
+		}
+
+		// copy memory from another memory object (with resize)
+		Memory& operator=(const Memory& memory) {
+			if (ptr + memory.size > end)
+				return *this;
+			create(memory.size);
+			memcpy(start, memory.start, memory.size);
+			return *this;
+		}
+
+		// attach memory to another memory object
+		Memory& operator=(Memory* memory) {
+			free();
+			attach(memory->start, memory->size);
+			return *this;
+		}
+
+		// add memory data from another memory object
+		Memory& operator+=(const Memory& memory) {
+			if (ptr + memory.size > end)
+				return *this;
+			memcpy(ptr, memory.start, memory.size);
+			ptr += memory.size;
+			return *this;
+		}
+
+		//operator int() {
+		//	if (ptr + sizeof(int) > end) {
+		//		ptr = end;
+		//		return 0;
+		//	}
+		//	ptr += sizeof(int);
+		//	return *(int*)(ptr - sizeof(int));
+		//}
+
+		//operator float() {
+		//	if (ptr + sizeof(float) > end) {
+		//		ptr = end;
+		//		return 0;
+		//	}
+		//	ptr += sizeof(float);
+		//	return *(float*)(ptr - sizeof(float));
+		//}
+
+	//	int geti1() {
+	//		if ((++_ptr) > _end) {
+	//			if (_ptr == _end)
+	//				return (*(BYTE*)(_ptr - 1));
+	//			_ptr = _end;
+	//			return 0;
+	//		}
+	//		return (*(int*)(_ptr - 1)) & 0xFF;
+	//	}
+
+	//	int geti2() {
+	//		if ((_ptr += 2) >/*=*/ _end) {
+	//			//            if(_ptr == _end)
+	//			//                return (*(short*)(_ptr - 2));
+	//			_ptr = _end;
+	//			return 0;
+	//		}
+	//		return (*(int*)(_ptr - 2)) & 0xFFFF;
+	//	}
+
+	//	//	int geti3() {
+	//	//		if ((_ptr += 3) > _end) {
+	//	//			_ptr = _end;
+	//	//			return 0;
+	//	//		}
+	//	//		return (*(int*)(_ptr - 3)) & 0xFFFFFF;
+	//	//	}
+
+	//	int geti4() {
+	//		if ((_ptr += 4) > _end) {
+	//			_ptr = _end;
+	//			return 0;
+	//		}
+	//		return (*(int*)(_ptr - 4)) & 0xFFFFFFFF;
+	//	}
+
+	//	int geti(const int size) {
+	//		switch (size) {
+	//		case 1: return geti1();
+	//		case 2: return geti2();
+	//			//		case 3: return geti3();
+	//		case 4: return geti4();
+	//		default:
+	//			int number = getc();
+	//			for (int i = 1; i < size; i++)           // (collate bytes into multi-byte integer)
+	//				number += (1 << (i * 8)) * getc();  // pow(256.0,  i) * getc();		//
+	//			return number;							// (return results)
+	//		}
+	//	}
+
+	//	int getbe(int size) {
+	//		int number = getc();
+	//		while (--size) {
+	//			number <<= 8;
+	//			number += getc();
+	//		}
+	//		return number;
+	//	}
+
+	//	bool putc(char c) {
+	//		if (_ptr < _end) {
+	//			*_ptr++ = c;
+	//			return true;
+	//		}
+	//		return false;
+	//	}
+
+	//	size_t write(const void* src, const size_t size, const size_t count) {
+	//		if ((_ptr + size * count) <= _end) {
+	//			memcpy(_ptr, src, size * count);
+	//			_ptr += size * count;
+	//			return size;
+	//		}
+	//		else {
+	//			_ptr = _end;
+	//		}
+	//		return 0;
+	//	}
+
+	//	/*int getshort(){
+	//		_ptr+=sizeof(short);
+	//		if(_ptr > _end){
+	//			_ptr = _end;
+	//			return 0;
+	//		}
+	//		return *(int*)(_ptr-sizeof(short));
+	//	}
+
+	//	int getint(){
+	//		_ptr+=sizeof(int);
+	//		if(_ptr > _end){
+	//			_ptr = _end;
+	//			return 0;
+	//		}
+	//		return *(int*)(_ptr-sizeof(int));
+	//	}*/
+
+	//	bool eof() const {
+	//		return _ptr >= _end;
+	//	}
+
+	//	int getvari(void)
+	//	{
+	//		int    value;
+	//		short	c;
+
+	//		if ((value = getc()) & 0x80) {
+	//			value &= 0x7f;
+	//			do {
+	//				value = (value << 7) + ((c = getc()) & 0x7f);
+	//			} while (c & 0x80);
+	//		}
+	//		return value;
+	//	}
+
+	//	char* gets(int length) {
+	//		if ((_ptr + length) >= _end) {
+	//			_ptr = _end;
+	//			_string[0] = 0;
+	//		}
+	//		else {
+	//			memcpy(_string, _ptr, MIN(length, 255));
+	//			_string[MIN(length, 255)] = 0;
+	//			_ptr += length;
+	//		}
+	//		return _string;
+	//	}
+
+	//	char* gets0(int length) {
+	//		if ((_ptr + length) >= _end) {
+	//			_ptr = _end;
+	//			_string[0] = 0;
+	//		}
+	//		else {
+	//			memcpy(_string, _ptr, MIN(length, 255));
+	//			_string[MIN(length, 255)] = 0;
+	//			if (!_string[0])
+	//				_string[0] = ' ';
+	//			_ptr += length;
+	//		}
+	//		return _string;
+	//	}
+
+	//	char* gets_any(const char* const of) {
+	//		_string[0] = 0;
+
+	//		int length = 0;
+	//		while (!eof() && length < 255) {
+	//			unsigned char ch = *_ptr;
+	//			if (strchr(of, ch)) { // valid character
+	//				_string[length++] = ch;
+	//				_ptr++;
+	//			}
+	//			else {
+	//				_string[length] = 0;
+	//				return _string;
+	//			}
+	//		}
+	//		_string[length] = 0;
+	//		return _string;
+	//	}
+
+	//	static bool isNumeric(char x) {
+	//		return (x >= '0' && x <= '9');
+	//	}
+
+	//	char* gets_numeric() {
+	//		_string[0] = 0;
+
+	//		int length = 0;
+	//		while (!eof() && length < 255) {
+	//			unsigned char ch = *_ptr;
+	//			if (isNumeric(ch)) { // valid character
+	//				_string[length++] = ch;
+	//				_ptr++;
+	//			}
+	//			else {
+	//				_string[length] = 0;
+	//				return _string;
+	//			}
+	//		}
+	//		_string[length] = 0;
+	//		return _string;
+	//	}
+
+	//	static bool isHexadecimal(char x) {
+	//		return (x >= 'A' && x <= 'F') || (x >= '0' && x <= '9');
+	//	}
+
+	//	char* gets_hex() {
+	//		_string[0] = 0;
+
+	//		int length = 0;
+	//		while (!eof() && length < 255) {
+	//			unsigned char ch = *_ptr;
+	//			if (isHexadecimal(ch)) { // valid character
+	//				_string[length++] = ch;
+	//				_ptr++;
+	//			}
+	//			else {
+	//				_string[length] = 0;
+	//				return _string;
+	//			}
+	//		}
+	//		_string[length] = 0;
+	//		return _string;
+	//	}
+
+	//	void gets(char* string, int length) {
+	//		if ((_ptr + length) >= _end) {
+	//			_ptr = _end;
+	//			return;
+	//		}
+	//		memcpy(string, _ptr, length);
+	//		string[length] = 0;
+	//		_ptr += length;
+	//	}
+
+	//	/*	void gets(std::string& string, int length){
+	//			if((_ptr + length) >= _end){
+	//				_ptr = _end;
+	//				return;
+	//			}
+
+	//	//		memcpy(string, _ptr, length);
+	//	//		string[length] = 0;
+	//			string.copy((char*)_ptr, length);
+	//			string.append(0);
+
+	//			_ptr += length;
+	//		}*/
+
+	//	void gets(char* string) {
+	//		if (eof()) return;
+	//		gets(string, getc());
+	//	}
+
+	//	/*void gets0(char* string, int length){
+	//		if((_ptr + length) >= _end){
+	//			_ptr = _end;
+	//			return;
+	//		}
+	//		memcpy(string, _ptr, length);
+	//		string[length] = 0;
+	//		if(string[0] == 0)
+	//			string[0] = ' ';
+	//		_ptr += length;
+	//	}*/
+
+	//	void gets(char* string, char terminator, unsigned int length) {
+	//		const BYTE_PTR _end = std::min(_ptr + length, this->_end);
+	//		BYTE_PTR _offset;
+	//		for (_offset = _ptr; _offset < _end; _offset++) {
+	//			if (*_offset == terminator)
+	//				break;
+	//		}
+	//		//		if(_offset != _end){
+	//		const unsigned int _len = (unsigned int)(_offset - _ptr);
+	//		memcpy(string, _ptr, _len);
+	//		string[std::min(length - 1, _len)] = 0;
+	//		//		}
+	//		_ptr = _offset;
+	//	}
+
+	//	static bool isAlphaNumeric(char x) {
+	//		return (x >= 'a' && x <= 'z') || (x >= 'A' && x <= 'Z') || (x >= '0' && x <= '9');
+	//	}
+
+	//	void gettag(char* string) {
+	//		while (isAlphaNumeric(*_ptr)) {
+	//			*string++ = *_ptr++;
+	//		}
+	//		*string = 0;
+	//	}
+
+	//	void getcs(char* string) {
+	//		if (_ptr > _end) {
+	//			string[0] = 0;
+	//			return;
+	//		}
+	//		const int length = *_ptr;
+	//		if ((_ptr + length) > _end) {
+	//			string[0] = 0;
+	//			return;
+	//		}
+	//		_ptr++;
+	//		memcpy(string, _ptr, length);
+	//		_ptr += length;
+	//	}
+
+	//	int read(void* to, const int size) {
+	//		if ((_ptr + size) > _end) {
+	//			_ptr = _end;
+	//			return 0;
+	//		}
+	//		memcpy(to, _ptr, size);
+	//		_ptr += size;
+	//		return size;
+	//	}
+
+	//	void skip(const int size) {
+	//		if ((_ptr + size) > _end) {
+	//			_ptr = _end;
+	//			return;
+	//		}
+	//		_ptr += size;
+	//	}
+
+	//	void skip_any(char token) {
+	//		while (!eof()) {
+	//			if (*_ptr != token)
+	//				return;
+	//			_ptr++;
+	//		}
+	//	}
+
+	//	void skip_any(const char* tokens) {
+	//		while (!eof()) {
+	//			const char* pTokens = tokens;
+	//			while (*pTokens != '\0') {
+	//				if (*_ptr == *pTokens)
+	//					break;
+	//				pTokens++;
+	//			}
+	//			if (*pTokens)
+	//				_ptr++;
+	//			else
+	//				return;
+	//		}
+	//	}
+
+	//	bool skip_to(char token) {
+	//		while (!eof()) {
+	//			if (*_ptr == token)
+	//				return true;
+	//			_ptr++;
+	//		}
+	//		return false;
+	//	}
+
+	//	bool skip_to(const char* token) {
+	//		size_t length = strlen(token);
+	//		while (!eof()) {
+	//			if (!memcmp(token, _ptr, length)) {
+	//				_ptr += length;
+	//				return true;
+	//			}
+	//			_ptr++;
+	//		}
+	//		return false;
+	//	}
+
+	//	void skip_to_any(const char* tokens) {
+	//		while (!eof()) {
+	//			const char* pTokens = tokens;
+	//			while (*pTokens != '\0') {
+	//				if (*_ptr == *pTokens++)
+	//					return;
+	//			}
+	//			_ptr++;
+	//		}
+	//	}
+
+	//	bool match_i(const char* stuff) {													// matches given text with file
+	//		size_t length = strlen(stuff);																	// (reset expectation)
+	//		if (!_strnicmp(stuff, (const char*)_ptr, length)) {
+	//			_ptr += length;
+	//			return true;
+	//		}
+	//		return false;
+	//	}
+
+	//	bool match(const char* stuff) {													// matches given text with file
+	//		size_t length = strlen(stuff);																	// (reset expectation)
+	//		if (!memcmp(stuff, _ptr, length)) {
+	//			_ptr += length;
+	//			return true;
+	//		}
+	//		return false;
+	//	}																																				//
+
+	//	bool match(char stuff) {													// matches given text with file
+	//		if (*_ptr == stuff) {
+	//			_ptr++;
+	//			return true;
+	//		}
+	//		return false;
+	//	}
+
+	//	// in-place character replacement
+	//	int replace(BYTE find, BYTE replace) {
+	//		int nbReplaced = 0;
+	//		BYTE_PTR ptr = _buf;
+	//		while (ptr < _end) {
+	//			if (*ptr == find)
+	//				*ptr = replace;
+	//			nbReplaced++;
+	//			ptr++;
+	//		}
+	//		return nbReplaced;
+	//	}
+
+	//	// in-place phrase replacement
+	//	int replace_fast(const char* find, const char* replace) {
+	//		// build new string
+	//		const char* str = (const char*)_buf;
+	//		const char* end = (const char*)_end;
+	//		const int length = (int)strlen(replace);
+	//		int nbReplaced = 0;
+
+	//		while (str < end) {
+	//			if (!memcmp(str, find, length)) { // match
+	//				memcpy((void*)str, replace, length);
+	//				str += length;
+	//				nbReplaced++;
+	//			}
+	//			else {
+	//				str++;
+	//			}
+	//		}
+	//		return nbReplaced;
+	//	}
+
+	//	int replace(const char* find, const char* replace) {
+	//		const int cbFind = (int)strlen(find);
+	//		const int cbReplace = (int)strlen(replace);
+	//		if (cbFind == cbReplace) // no memory re-allocation required
+	//			return replace_fast(find, replace);
+
+	//		// build new string
+	//		std::string new_str;
+	//		const char* str = (const char*)_buf;
+	//		const char* last = str;
+	//		const char* end = (const char*)_end;
+	//		int nbReplaced = 0;
+
+	//		while (str < end) {
+	//			if (!memcmp(str, find, cbFind)) { // match
+	//				new_str.append(last, str - last); // catch-up
+	//				new_str += replace;
+	//				str += cbFind;
+	//				last = str;
+	//				nbReplaced++;
+	//			}
+	//			else {
+	//				str++;
+	//			}
+	//		}
+	//		if (last < end)
+	//			new_str.append(last, end - last);
+
+	//		// replace buffer with new string
+	//		create((int)new_str.length());
+	//		memcpy(_buf, new_str.data(), new_str.length());
+	//		return nbReplaced;
+	//	}
+
+	//	bool match_any(const char* stuffs) {
+	//		while (*stuffs != '\0') {
+	//			if (*_ptr == *stuffs++) {
+	//				_ptr++;
+	//				return true;
+	//			}
+	//		}
+	//		return false;
+	//	}
+
+	//	unsigned int length() const { return _len; }
+	//	const BYTE_PTR buffer() const { return _buf; }
+	//	BYTE_PTR buffer() { return _buf; }
+	//	BYTE_PTR pointer() { return _ptr; }
+	//	BYTE_PTR* ppointer() { return &_ptr; }
+
+	//	unsigned int offset() const { return (unsigned int)(_ptr - _buf); }
+	//	bool seek(unsigned int offset) {
+	//		_ptr = _buf + offset;
+	//		if (_ptr > _end) {
+	//			_ptr = _end;
+	//			return false;
+	//		}
+	//		else return true;
+	//	}
+	//protected:
+	//	BYTE_PTR _buf;
+	//	unsigned int _len;
+
+	//	BYTE_PTR _end;
+	//	BYTE_PTR _ptr;
+
+	//	char _string[256];
+	};
+
 	/// String of characters representing text.
 	template<int SIZE>
 	struct Text {
@@ -506,9 +1372,207 @@ namespace klang {
 		return destination;
 	}
 
-	/// A multi-channel audio signal (e.g. stereo).
+	/// @cond
+	/// SIMD vectors for multi-channel signals (widest available width that divides the channel count)
+	namespace simd {
+
+		/// Scalar fallback (1 lane)
+		struct f32x1 {
+			static constexpr int width = 1;
+			float v;
+			static f32x1 load(const float* p) { return { *p }; }
+			static f32x1 loadu(const float* p) { return { *p }; }
+			static f32x1 set(float x) { return { x }; }
+			void store(float* p) const { *p = v; }
+			void storeu(float* p) const { *p = v; }
+			float sum() const { return v; }
+			f32x1 operator+(const f32x1 x) const { return { v + x.v }; }
+			f32x1 operator-(const f32x1 x) const { return { v - x.v }; }
+			f32x1 operator*(const f32x1 x) const { return { v * x.v }; }
+			f32x1 operator/(const f32x1 x) const { return { v / x.v }; }
+		};
+
+#if KLANG_SSE
+		/// SSE (4 lanes)
+		struct f32x4 {
+			static constexpr int width = 4;
+			__m128 v;
+			static f32x4 load(const float* p) { return { _mm_load_ps(p) }; }
+			static f32x4 loadu(const float* p) { return { _mm_loadu_ps(p) }; }
+			static f32x4 set(float x) { return { _mm_set1_ps(x) }; }
+			void store(float* p) const { _mm_store_ps(p, v); }
+			void storeu(float* p) const { _mm_storeu_ps(p, v); }
+			float sum() const {
+				const __m128 shuffle = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+				const __m128 sums = _mm_add_ps(v, shuffle);
+				return _mm_cvtss_f32(_mm_add_ss(sums, _mm_movehl_ps(shuffle, sums)));
+			}
+			f32x4 operator+(const f32x4 x) const { return { _mm_add_ps(v, x.v) }; }
+			f32x4 operator-(const f32x4 x) const { return { _mm_sub_ps(v, x.v) }; }
+			f32x4 operator*(const f32x4 x) const { return { _mm_mul_ps(v, x.v) }; }
+			f32x4 operator/(const f32x4 x) const { return { _mm_div_ps(v, x.v) }; }
+		};
+#elif KLANG_NEON
+		/// NEON (4 lanes)
+		struct f32x4 {
+			static constexpr int width = 4;
+			float32x4_t v;
+			static f32x4 load(const float* p) { return { vld1q_f32(p) }; }
+			static f32x4 loadu(const float* p) { return { vld1q_f32(p) }; }
+			static f32x4 set(float x) { return { vdupq_n_f32(x) }; }
+			void store(float* p) const { vst1q_f32(p, v); }
+			void storeu(float* p) const { vst1q_f32(p, v); }
+			float sum() const { return vaddvq_f32(v); }
+			f32x4 operator+(const f32x4 x) const { return { vaddq_f32(v, x.v) }; }
+			f32x4 operator-(const f32x4 x) const { return { vsubq_f32(v, x.v) }; }
+			f32x4 operator*(const f32x4 x) const { return { vmulq_f32(v, x.v) }; }
+			f32x4 operator/(const f32x4 x) const { return { vdivq_f32(v, x.v) }; }
+		};
+#endif
+
+#if KLANG_AVX
+		/// AVX (8 lanes)
+		struct f32x8 {
+			static constexpr int width = 8;
+			__m256 v;
+			static f32x8 load(const float* p) { return { _mm256_load_ps(p) }; }
+			static f32x8 loadu(const float* p) { return { _mm256_loadu_ps(p) }; }
+			static f32x8 set(float x) { return { _mm256_set1_ps(x) }; }
+			void store(float* p) const { _mm256_store_ps(p, v); }
+			void storeu(float* p) const { _mm256_storeu_ps(p, v); }
+			float sum() const { return f32x4{ _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)) }.sum(); }
+			f32x8 operator+(const f32x8 x) const { return { _mm256_add_ps(v, x.v) }; }
+			f32x8 operator-(const f32x8 x) const { return { _mm256_sub_ps(v, x.v) }; }
+			f32x8 operator*(const f32x8 x) const { return { _mm256_mul_ps(v, x.v) }; }
+			f32x8 operator/(const f32x8 x) const { return { _mm256_div_ps(v, x.v) }; }
+		};
+#endif
+
+#if KLANG_AVX512
+		/// AVX-512 (16 lanes)
+		struct f32x16 {
+			static constexpr int width = 16;
+			__m512 v;
+			static f32x16 load(const float* p) { return { _mm512_load_ps(p) }; }
+			static f32x16 loadu(const float* p) { return { _mm512_loadu_ps(p) }; }
+			static f32x16 set(float x) { return { _mm512_set1_ps(x) }; }
+			void store(float* p) const { _mm512_store_ps(p, v); }
+			void storeu(float* p) const { _mm512_storeu_ps(p, v); }
+			float sum() const { return _mm512_reduce_add_ps(v); }
+			f32x16 operator+(const f32x16 x) const { return { _mm512_add_ps(v, x.v) }; }
+			f32x16 operator-(const f32x16 x) const { return { _mm512_sub_ps(v, x.v) }; }
+			f32x16 operator*(const f32x16 x) const { return { _mm512_mul_ps(v, x.v) }; }
+			f32x16 operator/(const f32x16 x) const { return { _mm512_div_ps(v, x.v) }; }
+		};
+#endif
+
+		/// Vector width used for SIZE floats
+		template<int SIZE>
+		constexpr int width() {
+#if KLANG_AVX512
+			if (SIZE % 16 == 0) return 16;
+#endif
+#if KLANG_AVX
+			if (SIZE % 8 == 0) return 8;
+#endif
+#if KLANG_SSE || KLANG_NEON
+			if (SIZE % 4 == 0) return 4;
+#endif
+			return 1;
+		}
+
+		/// Storage alignment for SIZE floats (independent of instruction set, so layout is consistent across builds)
+		template<int SIZE>
+		constexpr int align() {
+			return SIZE % 16 == 0 ? 64 : SIZE % 8 == 0 ? 32 : SIZE % 4 == 0 ? 16 : int(alignof(float));
+		}
+
+		template<int WIDTH> struct lanes { using type = f32x1; };
+#if KLANG_SSE || KLANG_NEON
+		template<> struct lanes<4> { using type = f32x4; };
+#endif
+#if KLANG_AVX
+		template<> struct lanes<8> { using type = f32x8; };
+#endif
+#if KLANG_AVX512
+		template<> struct lanes<16> { using type = f32x16; };
+#endif
+		template<int SIZE> using vector = typename lanes<width<SIZE>()>::type;
+
+		/// out = a (op) b
+		template<int SIZE, class OPERATOR>
+		inline void apply(float* out, const float* a, const float* b, OPERATOR op) {
+			using V = vector<SIZE>;
+			for (int i = 0; i < SIZE; i += V::width)
+				op(V::load(a + i), V::load(b + i)).store(out + i);
+		}
+
+		/// out = a (op) x
+		template<int SIZE, class OPERATOR>
+		inline void apply(float* out, const float* a, float x, OPERATOR op) {
+			using V = vector<SIZE>;
+			const V b = V::set(x);
+			for (int i = 0; i < SIZE; i += V::width)
+				op(V::load(a + i), b).store(out + i);
+		}
+
+		/// out = x (op) b
+		template<int SIZE, class OPERATOR>
+		inline void apply(float* out, float x, const float* b, OPERATOR op) {
+			using V = vector<SIZE>;
+			const V a = V::set(x);
+			for (int i = 0; i < SIZE; i += V::width)
+				op(a, V::load(b + i)).store(out + i);
+		}
+
+		/// Horizontal sum
+		template<int SIZE>
+		inline float sum(const float* a) {
+			using V = vector<SIZE>;
+			V total = V::load(a);
+			for (int i = V::width; i < SIZE; i += V::width)
+				total = total + V::load(a + i);
+			return total.sum();
+		}
+
+		/// Dot product
+		template<int SIZE>
+		inline float dot(const float* a, const float* b) {
+			using V = vector<SIZE>;
+			V total = V::load(a) * V::load(b);
+			for (int i = V::width; i < SIZE; i += V::width)
+				total = total + V::load(a + i) * V::load(b + i);
+			return total.sum();
+		}
+
+		/// out += in * gain, with gain ramping linearly from..to over length samples (any alignment)
+		inline void mix(float* out, const float* in, float from, float to, int length) {
+			using V = vector<16>; // widest available
+			int s = 0;
+			if (from == to) {
+				const V gain = V::set(from);
+				for (; s + V::width <= length; s += V::width)
+					(V::loadu(out + s) + V::loadu(in + s) * gain).storeu(out + s);
+				for (; s < length; s++)
+					out[s] += in[s] * from;
+			} else {
+				const float step = (to - from) / length;
+				float steps[V::width];
+				for (int i = 0; i < V::width; i++)
+					steps[i] = step * i;
+				const V ramp = V::loadu(steps);
+				for (; s + V::width <= length; s += V::width)
+					(V::loadu(out + s) + V::loadu(in + s) * (V::set(from + step * s) + ramp)).storeu(out + s);
+				for (; s < length; s++)
+					out[s] += in[s] * (from + step * s);
+			}
+		}
+	};
+	/// @endcond
+
+	/// A multi-channel audio signal (e.g. stereo; 4, 8 and 16 channels are SIMD-aligned and vectorised).
 	template<int CHANNELS = 2>
-	struct signals {
+	struct alignas(simd::align<CHANNELS>()) signals {
 		/// @cond
 		union {
 			signal value[CHANNELS]; ///< Array of channel values.
@@ -517,22 +1581,28 @@ namespace klang {
 				signal r; ///< Right channel
 			};
 		};
+
+		float* data() { return &value[0].value; }
+		const float* data() const { return &value[0].value; }
 		/// @endcond
 
-		/// Return the mono mix of a stereo channel.
-		signal mono() const { return (l + r) * 0.5f; }
+		/// Return the mono mix of a stereo channel (or average of all channels).
+		signal mono() const { return sum() * (1.f / CHANNELS); }
+
+		/// Return the sum of all channels.
+		signal sum() const { return simd::sum<CHANNELS>(data()); }
 
 		/// Return a reference to the signal at the specified index (0 = left, 1 = right).
 		signal& operator[](int index) { return value[index]; }
 		/// Return a read-only reference to the signal  at the specified index (0 = left, 1 = right).
 		const signal& operator[](int index) const { return value[index]; }
 
-		/// Create a stereo signal with the given value.
-		signals(float initial = 0.f) : l(initial), r(initial) {}
-		/// Create a stereo signal with the given value.
-		signals(double initial) : l((float)initial), r((float)initial) {}
-		/// Create a stereo signal with the given value.
-		signals(int initial) : l((float)initial), r((float)initial) {}
+		/// Create a multi-channel signal with the given value (in all channels).
+		signals(float initial = 0.f) { for (int v = 0; v < CHANNELS; v++) value[v] = initial; }
+		/// Create a multi-channel signal with the given value (in all channels).
+		signals(double initial) : signals((float)initial) {}
+		/// Create a multi-channel signal with the given value (in all channels).
+		signals(int initial) : signals((float)initial) {}
 
 		/// Create a stereo signal with the given left and right value.
 		signals(float left, float right) : l(left), r(right) {}
@@ -563,22 +1633,25 @@ namespace klang {
 		}
 
 		/// Add (mix) another signal to the signal.
-		signals& operator+=(const signals x) { for (int v = 0; v < CHANNELS; v++) value[v] += x[v]; return *this; }
+		signals& operator+=(const signals x) { simd::apply<CHANNELS>(data(), data(), x.data(), std::plus<>()); return *this; }
 		/// Subtract another signal from the signal.
-		signals& operator-=(const signals x) { for (int v = 0; v < CHANNELS; v++) value[v] -= x[v]; return *this; }
+		signals& operator-=(const signals x) { simd::apply<CHANNELS>(data(), data(), x.data(), std::minus<>()); return *this; }
 		/// Multiply (modulate) signal by another signal.
-		signals& operator*=(const signals x) { for (int v = 0; v < CHANNELS; v++) value[v] *= x[v]; return *this; }
+		signals& operator*=(const signals x) { simd::apply<CHANNELS>(data(), data(), x.data(), std::multiplies<>()); return *this; }
 		/// Divide signal by another signal.
-		signals& operator/=(const signals x) { for (int v = 0; v < CHANNELS; v++) value[v] /= x[v]; return *this; }
+		signals& operator/=(const signals x) { simd::apply<CHANNELS>(data(), data(), x.data(), std::divides<>()); return *this; }
 
 		/// Add two multi-channel signals together.
-		signals operator+(const signals x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] += x[v]; return s; }
+		signals operator+(const signals x) const { signals s; simd::apply<CHANNELS>(s.data(), data(), x.data(), std::plus<>()); return s; }
 		/// Subtract one multi-channel signal from another.
-		signals operator-(const signals x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] -= x[v]; return s; }
+		signals operator-(const signals x) const { signals s; simd::apply<CHANNELS>(s.data(), data(), x.data(), std::minus<>()); return s; }
 		/// Multiply (modulate) two multi-channel signals.
-		signals operator*(const signals x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] *= x[v]; return s; }
+		signals operator*(const signals x) const { signals s; simd::apply<CHANNELS>(s.data(), data(), x.data(), std::multiplies<>()); return s; }
 		/// Divide one multi-channel signal by another.
-		signals operator/(const signals x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] /= x[v]; return s; }
+		signals operator/(const signals x) const { signals s; simd::apply<CHANNELS>(s.data(), data(), x.data(), std::divides<>()); return s; }
+
+		/// Return a negated copy of the multi-channel signal.
+		signals operator-() const { signals s; simd::apply<CHANNELS>(s.data(), 0.f, data(), std::minus<>()); return s; }
 
 		//signals& operator+=(const signal x) { for (int v = 0; v < CHANNELS; v++) value[v] += x; return *this; }
 		//signals& operator-=(const signal x) { for (int v = 0; v < CHANNELS; v++) value[v] -= x; return *this; }
@@ -586,54 +1659,57 @@ namespace klang {
 		//signals& operator/=(const signal x) { for (int v = 0; v < CHANNELS; v++) value[v] /= x; return *this; }
 
 		/// Return a copy of the multi-channel signal, adding a mono signal to each channel.
-		signals operator+(const signal x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] += x; return s; }
+		signals operator+(const signal x) const { return operator+(x.value); }
 		/// Return a copy of the multi-channel signal, subtracting a mono signal from each channel.
-		signals operator-(const signal x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] -= x; return s; }
+		signals operator-(const signal x) const { return operator-(x.value); }
 		/// Return a copy of the multi-channel signal, multiplying (modulating) each channel by a mono signal.
-		signals operator*(const signal x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] *= x; return s; }
+		signals operator*(const signal x) const { return operator*(x.value); }
 		/// Return a copy of the multi-channel signal, dividing each channel by a mono signal.
-		signals operator/(const signal x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] /= x; return s; }
+		signals operator/(const signal x) const { return operator/(x.value); }
 
 		/// Return a copy of the signal with each channel offset by x.
-		signals operator+(float x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] += x; return s; }
+		signals operator+(float x) const { signals s; simd::apply<CHANNELS>(s.data(), data(), x, std::plus<>()); return s; }
 		/// Return a copy of the signal with each channel offset by -x.
-		signals operator-(float x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] -= x; return s; }
+		signals operator-(float x) const { signals s; simd::apply<CHANNELS>(s.data(), data(), x, std::minus<>()); return s; }
 		/// Return a copy of the signal  with each channel scaled by x.
-		signals operator*(float x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] *= x; return s; }
+		signals operator*(float x) const { signals s; simd::apply<CHANNELS>(s.data(), data(), x, std::multiplies<>()); return s; }
 		/// Return a copy of the signal with each channel divided by x.
-		signals operator/(float x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] /= x; return s; }
+		signals operator/(float x) const { signals s; simd::apply<CHANNELS>(s.data(), data(), x, std::divides<>()); return s; }
 
 		/// Return a copy of the signal with each channel offset by x.
-		signals operator+(double x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] += x; return s; }
+		signals operator+(double x) const { return operator+((float)x); }
 		/// Return a copy of the signal with each channel offset by -x.
-		signals operator-(double x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] -= x; return s; }
+		signals operator-(double x) const { return operator-((float)x); }
 		/// Return a copy of the signal  with each channel scaled by x.
-		signals operator*(double x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] *= x; return s; }
+		signals operator*(double x) const { return operator*((float)x); }
 		/// Return a copy of the signal with each channel divided by x.
-		signals operator/(double x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] /= x; return s; }
+		signals operator/(double x) const { return operator/((float)x); }
 
 		/// Return a copy of the signal with each channel offset by x.
-		signals operator+(int x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] += x; return s; }
+		signals operator+(int x) const { return operator+((float)x); }
 		/// Return a copy of the signal with each channel offset by -x.
-		signals operator-(int x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] -= x; return s; }
+		signals operator-(int x) const { return operator-((float)x); }
 		/// Return a copy of the signal  with each channel scaled by x.
-		signals operator*(int x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] *= x; return s; }
+		signals operator*(int x) const { return operator*((float)x); }
 		/// Return a copy of the signal with each channel divided by x.
-		signals operator/(int x) const { signals s = *this; for (int v = 0; v < CHANNELS; v++) s[v] /= x; return s; }
+		signals operator/(int x) const { return operator/((float)x); }
 	};
 
 	/// Return a copy of the signal with each channel offset by x.
 	template<int CHANNELS = 2> inline signals<CHANNELS> operator+(float x, const signals<CHANNELS>& y) { return y + x; }
 	/// Return a copy of the signal with each channel subtracted from  x.
-	template<int CHANNELS = 2> inline signals<CHANNELS> operator-(float x, const signals<CHANNELS>& y) { return -y + x; }
+	template<int CHANNELS = 2> inline signals<CHANNELS> operator-(float x, const signals<CHANNELS>& y) {
+		signals<CHANNELS> s;
+		simd::apply<CHANNELS>(s.data(), x, y.data(), std::minus<>());
+		return s;
+	}
 	/// Return a copy of the signal  with each channel scaled by x.
 	template<int CHANNELS = 2> inline signals<CHANNELS> operator*(float x, const signals<CHANNELS>& y) { return y * x; }
 	/// Return a copy of the signal with each channel divided into x.
 	template<int CHANNELS = 2> inline signals<CHANNELS> operator/(float x, const signals<CHANNELS>& y) {
-		signals<CHANNELS> s = { 0.f };
-		for (int c = 0; c < CHANNELS; c++)
-			s[c] = x / y[c];
-		return std::move(s);
+		signals<CHANNELS> s;
+		simd::apply<CHANNELS>(s.data(), x, y.data(), std::divides<>());
+		return s;
 	}
 
 	/// @cond
@@ -689,15 +1765,18 @@ namespace klang {
 
 	/// @cond
 	struct params {
+		param local[8];
 		param* parameters;
 		const int size;
 
-		params(param p) : parameters(new param[1]), size(1) { parameters[0] = p; }
-		params(std::initializer_list<param> params) : parameters(new param[params.size()]), size((int)params.size()) {
+		params(param p) : parameters(local), size(1) { parameters[0] = p; }
+		params(std::initializer_list<param> params) : parameters(params.size() > 8 ? new param[params.size()] : local), size((int)params.size()) {
 			int index = 0;
 			for (param p : params)
 				parameters[index++] = p;
 		}
+		params(const params&) = delete;
+		~params() { if (parameters != local) delete[] parameters; }
 
 		param& operator[](int index) { return parameters[index]; }
 	};
@@ -749,33 +1828,34 @@ namespace klang {
 		return (*(const double*)&i - 1.0) * size;
 	}
 
-	/// Matrix processor
-	//template<int X, int Y = X>
-	struct Matrix {
-		float v[4][4] = { 0 };
+	namespace Generic {
+		/// Matrix processor (SIZE x SIZE, applied to signals<SIZE>)
+		template<int SIZE>
+		struct Matrix {
+			alignas(simd::align<SIZE>()) float v[SIZE][SIZE] = { 0 };
 
-		float* operator[](int col) { return v[col]; }
-		const float* operator[](int col) const { return v[col]; }
+			float* operator[](int col) { return v[col]; }
+			const float* operator[](int col) const { return v[col]; }
 
-		float& operator()(int col, int row) { return v[col][row]; }
-		float operator()(int col, int row) const { return v[col][row]; }
+			float& operator()(int col, int row) { return v[col][row]; }
+			float operator()(int col, int row) const { return v[col][row]; }
 
-		signals<4> operator<<(const signals<4>& in) const {
-			return { v[0][0] * in[0] + v[0][1] * in[1] + v[0][2] * in[2] + v[0][3] * in[3],
-					 v[1][0] * in[0] + v[1][1] * in[1] + v[1][2] * in[2] + v[1][3] * in[3],
-					 v[2][0] * in[0] + v[2][1] * in[1] + v[2][2] * in[2] + v[2][3] * in[3],
-					 v[3][0] * in[0] + v[3][1] * in[1] + v[3][2] * in[2] + v[3][3] * in[3] };
-		}
-	};
+			signals<SIZE> operator<<(const signals<SIZE>& in) const {
+				signals<SIZE> out;
+				for (int col = 0; col < SIZE; col++)
+					out[col] = simd::dot<SIZE>(v[col], in.data());
+				return out;
+			}
 
-	inline signals<4> operator*(const signals<4>& in, const Matrix& m) {
-		return { m[0][0] * in[0] + m[0][1] * in[1] + m[0][2] * in[2] + m[0][3] * in[3],
-				 m[1][0] * in[0] + m[1][1] * in[1] + m[1][2] * in[2] + m[1][3] * in[3],
-				 m[2][0] * in[0] + m[2][1] * in[1] + m[2][2] * in[2] + m[2][3] * in[3],
-				 m[3][0] * in[0] + m[3][1] * in[1] + m[3][2] * in[2] + m[3][3] * in[3] };
+			// apply matrix to signal (non-template, so preferred over generic >>)
+			friend signals<SIZE> operator*(const signals<SIZE> in, const Matrix& m) { return m << in; }
+			friend signals<SIZE> operator>>(const signals<SIZE> in, const Matrix& m) { return m << in; }
+			friend signals<SIZE> operator>>(const signals<SIZE> in, Matrix& m) { return m << in; }
+		};
 	}
 
-	inline signals<4> operator>>(const signals<4>& in, const Matrix& m) { return operator*(in, m); }
+	/// Matrix processor (4 x 4)
+	using Matrix = Generic::Matrix<4>;
 
 	/// @cond
 	template<typename TYPE, typename _TYPE>
@@ -898,7 +1978,7 @@ namespace klang {
 	};
 
 	/// Sample rate constants
-	static struct SampleRate {
+	struct SampleRate {
 		float f;        ///< sample rate (float)
 		int i;          ///< sample rate (integer)
 		double d;       ///< sample rate (double)
@@ -906,10 +1986,206 @@ namespace klang {
 		float w;        ///< angular frequency (omega)
 		float nyquist;  ///< nyquist frequency (f / 2)
 
-		SampleRate(float sr) : f(sr), i(int(sr + 0.001f)), d((double)sr), inv(1.f / sr), w(2.0f * pi * inv), nyquist(sr / 2.f) {}
+		constexpr SampleRate(float sr) : f(sr), i(int(sr + 0.001f)), d((double)sr), inv(1.f / sr), w(2.0f * pi * (1.f / sr)), nyquist(sr / 2.f) {}
+
+		operator float() const { return f; }
+	};
+
+	/// Sample rate (of the context rendering on this thread; see Context)
+	THREAD_LOCAL static SampleRate fs(44100);
+
+	/// Processing context (owned per plugin instance)
+	struct Context {
+		/// Default sample rate of unconfigured contexts (process-wide; a host may set it from any thread)
+		inline static std::atomic<float> rate = 44100.f;
+
+		SampleRate fs = rate.load();         ///< sample rate
+		int maxBlock = KLANG_BLOCK_SIZE;     ///< maximum block size (from host)
+		bool configured = false;             ///< set by Plugin::configure(); until then, follows Context::rate
+#ifndef __wasm__
+		std::thread::id thread;              ///< thread last rendering this context
+#endif
+
+		Context() {}
+		Context(float sampleRate, int maxBlock = KLANG_BLOCK_SIZE) : fs(sampleRate), maxBlock(maxBlock), configured(true) {}
+
+		/// Applies the context to the calling thread (restoring the previous one on exit)
+		struct Scope {
+			const SampleRate previous;
+
+			Scope(Context& context) : previous(klang::fs) {
+				if (!context.configured) {
+					const float rate = Context::rate.load(std::memory_order_relaxed);
+					if (context.fs.f != rate)
+						context.fs = rate; // default changed (e.g. set by the host on another thread)
+				}
+				klang::fs = context.fs;
+#ifndef __wasm__
+				context.thread = std::this_thread::get_id();
+#endif
+			}
+			~Scope() { klang::fs = previous; }
+		};
+	};
+
+	/// Flush-to-zero / denormals-are-zero mode (scoped; previous mode restored on exit)
+	struct NoDenormals {
+#if defined(KLANG_MXCSR)
+		const unsigned int mxcsr;
+		NoDenormals() : mxcsr(_mm_getcsr()) { _mm_setcsr(mxcsr | 0x8040); } // FTZ (bit 15) + DAZ (bit 6)
+		~NoDenormals() { _mm_setcsr(mxcsr); }
+#elif defined(KLANG_FPCR)
+		unsigned long long fpcr;
+		NoDenormals() {
+			__asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+			__asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | (1ULL << 24))); // FZ (bit 24)
+		}
+		~NoDenormals() { __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr)); }
+#else
+		NoDenormals() {}
+#endif
+	};
+
+	/// Real-time (render) scope; flushes denormals and, with KLANG_TRAP_ALLOCATIONS defined, traps heap use
+	namespace Realtime {
+#ifdef KLANG_TRAP_ALLOCATIONS
+		THREAD_LOCAL inline int depth = 0;	///< nesting of render scopes (on this thread)
+		inline std::atomic<int> violations = 0;	///< heap allocations made while rendering (on any thread)
+
+		struct Scope {
+			NoDenormals denormals;
+			Scope() { depth++; }
+			~Scope() { depth--; }
+		};
+
+		inline void allocated() {
+			if (depth) {
+				violations++;
+				assert(!"klang: heap allocation during render");
+			}
+		}
+#else
+		struct Scope {
+			NoDenormals denormals;
+		};
+#endif
+	}
+
+	/// Worker thread pool (runs indexed jobs across threads; the calling thread also takes jobs)
+	struct Workers {
+		Workers() {}
+		~Workers() { stop(); }
+		Workers(const Workers&) = delete;
+		Workers& operator=(const Workers&) = delete;
+
+		// worker threads (in addition to the caller)
+		int size() const {
+#ifndef __wasm__
+			return (int)threads.size();
+#else
+			return 0;
+#endif
+		}
+
+		// (re)start with count threads in total, including the caller (allocates; call outside the render)
+		void start(int count) {
+			stop();
+#ifndef __wasm__
+			quit = false;
+			for (int t = 1; t < count; t++)
+				threads.emplace_back([this] { loop(); });
+#endif
+		}
+
+		void stop() {
+#ifndef __wasm__
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				quit = true;
+			}
+			wake.notify_all();
+			for (auto& thread : threads)
+				thread.join();
+			threads.clear();
+#endif
+		}
+
+		// run function(0 .. count-1), returning once all jobs are done (no allocation)
+		template<typename FUNCTION>
+		void run(int count, FUNCTION& function) {
+#ifndef __wasm__
+			if (threads.empty() || count < 2) {
+#endif
+				for (int i = 0; i < count; i++)
+					function(i);
+#ifndef __wasm__
+				return;
+			}
+			{
+				// wait out stragglers from the previous run, then publish the jobs
+				std::unique_lock<std::mutex> lock(mutex);
+				done.wait(lock, [this] { return active == 0; });
+				call = [](void* function, int i) { (*(FUNCTION*)function)(i); };
+				context = &function;
+				jobs = count;
+				pending.store(count);
+				next.store(0);
+				generation++;
+			}
+			wake.notify_all();
+			work();
+			std::unique_lock<std::mutex> lock(mutex);
+			done.wait(lock, [this] { return pending.load() == 0; });
+#endif
+		}
+
+#ifndef __wasm__
+	protected:
+		std::vector<std::thread> threads;
+		std::mutex mutex;
+		std::condition_variable wake, done;
+		unsigned int generation = 0;
+		int active = 0;
+		bool quit = false;
+
+		void (*call)(void*, int) = nullptr;
+		void* context = nullptr;
+		int jobs = 0;
+		std::atomic<int> next { 0 };
+		std::atomic<int> pending { 0 };
+
+		// take jobs until none are left
+		void work() {
+			int i;
+			while ((i = next.fetch_add(1)) < jobs) {
+				call(context, i);
+				if (pending.fetch_sub(1) == 1) {
+					std::lock_guard<std::mutex> lock(mutex);
+					done.notify_all();
+				}
+			}
+		}
 
-		operator float() { return f; }
-	} fs(44100); // sample rate
+		void loop() {
+			NoDenormals denormals;
+			unsigned int seen = 0;
+			for (;;) {
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					wake.wait(lock, [&] { return quit || generation != seen; });
+					if (quit)
+						return;
+					seen = generation;
+					active++;
+				}
+				work();
+				std::lock_guard<std::mutex> lock(mutex);
+				if (--active == 0)
+					done.notify_all();
+			}
+		}
+#endif
+	};
 
 	struct Amplitude;
 
@@ -959,6 +2235,89 @@ namespace klang {
 	/// Control parameter (velocity)
 	typedef Amplitude Velocity;
 
+	/// Parameter smoothing (linear or exponential ramp to a target over a set time; idle when at target)
+	struct Smoothing {
+		enum Shape { Linear, Exponential };
+
+		Shape shape = Exponential;
+		float time = 0.05f;		// ramp time (in seconds)
+		float current = 0;		// current (smoothed) value
+		float target = 0;		// target value
+		float step = 0;			// increment (linear) or coefficient (exponential)
+		int remaining = 0;		// samples until target reached
+
+		/// Jump straight to value (no ramp)
+		void reset(float value) {
+			current = target = value;
+			remaining = 0;
+		}
+
+		/// Set the target (starts a new ramp, if changed)
+		void set(float value) {
+			if (value == target)
+				return;
+			target = value;
+			remaining = std::max(1, int(time * fs));
+			step = (shape == Linear) ? (target - current) / remaining
+									 : expf(-6.9077553f / remaining); // -60dB over ramp
+		}
+
+		/// Is the ramp still moving?
+		bool ramping() const { return remaining > 0; }
+
+		/// Advance by one sample
+		float next() {
+			if (!remaining)
+				return current;
+			if (--remaining == 0)
+				current = target;
+			else if (shape == Linear)
+				current += step;
+			else
+				current = target + (current - target) * step;
+			return current;
+		}
+
+		/// Generate the next block of values
+		void process(signal* output, int length) {
+			if (!remaining) { // idle => constant
+				for (int s = 0; s < length; s++)
+					output[s] = current;
+				return;
+			}
+
+			const int ramp = length < remaining ? length : remaining;
+			if (shape == Linear) {
+				const float start = current;
+				for (int s = 0; s < ramp; s++)
+					output[s] = start + step * float(s + 1);
+			} else { // 4 decaying lanes, each stepping by step^4
+				float lane[4] = { current - target };
+				for (int l = 1; l < 4; l++)
+					lane[l] = lane[l - 1] * step;
+				for (int l = 0; l < 4; l++)
+					lane[l] *= step;
+				const float step4 = step * step * step * step;
+				int s = 0;
+				for (; s + 4 <= ramp; s += 4) {
+					for (int l = 0; l < 4; l++) {
+						output[s + l] = target + lane[l];
+						lane[l] *= step4;
+					}
+				}
+				for (int l = 0; s < ramp; s++, l++)
+					output[s] = target + lane[l];
+			}
+
+			remaining -= ramp;
+			if (!remaining)
+				output[ramp - 1] = target;
+			current = output[ramp - 1];
+			for (int s = ramp; s < length; s++)
+				output[s] = current;
+		}
+	};
+
 	/// UI control / parameter
 	struct Control
 	{
@@ -1000,12 +2359,39 @@ namespace klang {
 			bool contains(unsigned int c) const { return c >= start && c < (start + length); }
 		};
 
-		typedef Array<Caption, 128> Options;
+		/// Menu options (shared, separately stored captions; empty for most controls)
+		struct Options {
+			const Caption* items = nullptr;
+			unsigned int count = 0;
 
-		Caption name;           // name for control label / saved parameter
-		Type type = NONE;       // control type (see above)
+			Options() {}
+			Options(const Array<Caption, 128>& captions) : items(store(captions)), count(captions.size()) {}
 
-		float min;              // minimum control value (e.g. 0.0)
+			unsigned int size() const { return count; }
+			const Caption& operator[](int index) const { return items[index]; }
+
+		private:
+			// cold storage (identical lists shared across controls and plugin instances)
+			static const Caption* store(const Array<Caption, 128>& captions) {
+				if (!captions.size())
+					return nullptr;
+				static std::mutex mutex;
+				static std::vector<std::unique_ptr<std::vector<Caption>>> lists;
+				std::lock_guard<std::mutex> lock(mutex);
+				for (const auto& list : lists) {
+					if (list->size() == captions.size() && std::equal(list->begin(), list->end(), &captions[0],
+						[](const Caption& a, const Caption& b) { return a == b.c_str(); }))
+						return list->data();
+				}
+				lists.emplace_back(new std::vector<Caption>(&captions[0], &captions[0] + captions.size()));
+				return lists.back()->data();
+			}
+		};
+
+		Caption name;           // name for control label / saved parameter
+		Type type = NONE;       // control type (see above)
+
+		float min;              // minimum control value (e.g. 0.0)
 		float max;              // maximum control value (e.g. 1.0)
 		float initial;          // initial value for control (e.g. 0.0)
 
@@ -1014,14 +2400,28 @@ namespace klang {
 
 		signal value;           // current control value
 		signal smoothed;		// smoothed control value (filtered)
+		Smoothing smoothing;	// smoothing ramp (see smooth())
 
 		operator signal& () { return value; }
 		operator signal () const { return value; }
 		operator param() const { return value; }
 		operator float() const { return value.value; }
 
-		static constexpr float smoothing = 0.999f;
-		signal smooth() { return smoothed = smoothed * smoothing + (1.f - smoothing) * value; }
+		/// Smoothed value (per sample; ramps towards value)
+		signal smooth() {
+			smoothing.set(value);
+			return smoothed = smoothing.next();
+		}
+
+		/// Smoothed values (per block; constant when not ramping)
+		void smooth(signal* output, int length) {
+			smoothing.set(value);
+			smoothing.process(output, length);
+			smoothed = smoothing.current;
+		}
+
+		/// Is the control ramping to a new value? (e.g. to skip recalculating coefficients when not)
+		bool ramping() const { return smoothing.ramping() || smoothing.target != value.value; }
 
 		float range() const { return max - min; }
 		float normalise(float value) const { return range() ? (value - min) / range() : std::clamp(value, 0.f, 1.f); }
@@ -1050,10 +2450,10 @@ namespace klang {
 		template<typename TYPE> signal operator-(const Control& x) const { return value - (signal)x; }
 		template<typename TYPE> signal operator/(const Control& x) const { return value / (signal)x; }
 
-		template<typename TYPE> float operator+(TYPE x) const { return value + (signal)x; }
-		template<typename TYPE> float operator*(TYPE x) const { return value * (signal)x; }
-		template<typename TYPE> float operator-(TYPE x) const { return value - (signal)x; }
-		template<typename TYPE> float operator/(TYPE x) const { return value / (signal)x; }
+		template<typename TYPE> float operator+(TYPE& x) const { return value + (signal)x; }
+		template<typename TYPE> float operator*(TYPE& x) const { return value * (signal)x; }
+		template<typename TYPE> float operator-(TYPE& x) const { return value - (signal)x; }
+		template<typename TYPE> float operator/(TYPE& x) const { return value / (signal)x; }
 
 		template<typename TYPE> Control& operator<<(TYPE& in) { value = in; return *this; }		// assign to control with processing
 		template<typename TYPE> Control& operator<<(const TYPE& in) { value = in; return *this; }	// assign to control without/after processing
@@ -1092,6 +2492,7 @@ namespace klang {
 		operator param() const { return control->value; }
 		operator float() const { return control->value; }
 		signal smooth() { return control->smooth(); }
+		bool ramping() const { return control->ramping(); }
 
 		template<typename TYPE> Control& operator<<(TYPE& in) { control->value = in; return *control; }		// assign to control with processing
 		template<typename TYPE> Control& operator<<(const TYPE& in) { control->value = in; return *control; }	// assign to control without/after processing
@@ -1103,59 +2504,59 @@ namespace klang {
 
 	inline static Control Dial(const char* name, float min = 0.f, float max = 1.f, float initial = 0.f, Control::Size size = Automatic)
 	{
-		return { Caption::from(name), Control::ROTARY, min, max, initial, size, NoOptions, initial };
+		return { Caption::from(name), Control::ROTARY, min, max, initial, size, NoOptions, initial, initial, {} };
 	}
 
 	inline static Control Button(const char* name, Control::Size size = Automatic)
 	{
-		return { Caption::from(name), Control::BUTTON, 0, 1, 0.f, size, NoOptions, 0.f };
+		return { Caption::from(name), Control::BUTTON, 0, 1, 0.f, size, NoOptions, 0.f, 0.f, {} };
 	}
 
 	inline static Control Toggle(const char* name, bool initial = false, Control::Size size = Automatic)
 	{
-		return { Caption::from(name), Control::TOGGLE, 0, 1, initial ? 1.f : 0.f, size, NoOptions, initial ? 1.f : 0.f };
+		return { Caption::from(name), Control::TOGGLE, 0, 1, initial ? 1.f : 0.f, size, NoOptions, initial ? 1.f : 0.f, initial ? 1.f : 0.f, {} };
 	}
 
 	inline static Control Slider(const char* name, float min = 0.f, float max = 1.f, float initial = 0.f, Control::Size size = Automatic)
 	{
-		return { Caption::from(name), Control::SLIDER, min, max, initial, size, NoOptions, initial };
+		return { Caption::from(name), Control::SLIDER, min, max, initial, size, NoOptions, initial, initial, {} };
 	}
 
 	template<typename... Options>
 	static Control Menu(const char* name, const Options... options)
 	{
-		Control::Options menu;
+		Array<Caption, 128> menu;
 		const char* strings[] = { options... };
 		int nbValues = sizeof...(options);
 		for (int p = 0; p < nbValues; p++)
 			menu.add(Caption::from(strings[p]));
-		return { Caption::from(name), Control::MENU, 0, menu.size() - 1.f, 0, Automatic, menu, 0 };
+		return { Caption::from(name), Control::MENU, 0, menu.size() - 1.f, 0, Automatic, Control::Options(menu), 0, 0, {} };
 	}
 
 	template<typename... Options>
 	static Control Menu(const char* name, Control::Size size, const Options... options)
 	{
-		Control::Options menu;
+		Array<Caption, 128> menu;
 		const char* strings[] = { options... };
 		int nbValues = sizeof...(options);
 		for (int p = 0; p < nbValues; p++)
 			menu.add(Caption::from(strings[p]));
-		return { Caption::from(name), Control::MENU, 0, menu.size() - 1.f, 0, size, menu, 0 };
+		return { Caption::from(name), Control::MENU, 0, menu.size() - 1.f, 0, size, Control::Options(menu), 0, 0, {} };
 	}
 
 	inline static Control Meter(const char* name, float min = 0.f, float max = 1.f, float initial = 0.f, Control::Size size = Automatic)
 	{
-		return { Caption::from(name), Control::METER, min, max, initial, size, NoOptions, initial };
+		return { Caption::from(name), Control::METER, min, max, initial, size, NoOptions, initial, initial, {} };
 	}
 
 	inline static Control PitchBend(Control::Size size = Automatic)
 	{
-		return { { "PITCH\nBEND" }, Control::WHEEL, 0.f, 16384.f, 8192.f, size, NoOptions, 8192.f };
+		return { { "PITCH\nBEND" }, Control::WHEEL, 0.f, 16384.f, 8192.f, size, NoOptions, 8192.f, 8192.f, {} };
 	}
 
 	inline static Control ModWheel(Control::Size size = Automatic)
 	{
-		return { { "MOD\nWHEEL" }, Control::WHEEL, 0.f, 127.f, 0.f, size, NoOptions, 0.f };
+		return { { "MOD\nWHEEL" }, Control::WHEEL, 0.f, 127.f, 0.f, size, NoOptions, 0.f, 0.f, {} };
 	}
 
 	struct Group {
@@ -1180,14 +2581,53 @@ namespace klang {
 		Group(Control::Size size, Controls... ctrls) : name(""), size(size), controls{ std::forward<Controls>(ctrls)... } {}
 	};
 
+	/// Lock-free parameter exchange (written by host / UI thread; drained by audio thread once per render)
+	struct Exchange {
+		std::atomic<float> values[128];
+		std::atomic<unsigned int> dirty[4] = {}; // bitset of written parameters
+
+		/// Post a new parameter value (any thread)
+		void write(int index, float value) {
+			values[index].store(value, std::memory_order_relaxed);
+			dirty[index >> 5].fetch_or(1u << (index & 31), std::memory_order_release);
+		}
+
+		/// Apply written parameters (audio thread), as apply(index, value)
+		template<typename APPLY>
+		void drain(APPLY apply) {
+			for (int w = 0; w < 4; w++) {
+				unsigned int bits = dirty[w].load(std::memory_order_relaxed) ? dirty[w].exchange(0, std::memory_order_acquire) : 0;
+				while (bits) {
+					const int index = (w << 5) + lowest(bits);
+					bits &= bits - 1;
+					apply(index, values[index].load(std::memory_order_relaxed));
+				}
+			}
+		}
+
+	private:
+		static int lowest(unsigned int bits) {
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, bits);
+			return (int)index;
+#else
+			return __builtin_ctz(bits);
+#endif
+		}
+	};
+
 	/// Plugin UI controls
 	struct Controls : Array<Control, 128>
 	{
 		float value[128] = { 0 };
 		Array<Control::Group, 10> groups;
+		Exchange exchange; // parameter changes from host / UI (see Plugin::receive())
 
 		void operator+= (const Control& control) {
-			items[count++] = control;
+			items[count] = control;
+			items[count].smoothing.reset(control.value);
+			items[count++].smoothed = control.value;
 		}
 
 		void operator= (const Controls& controls) {
@@ -1216,9 +2656,17 @@ namespace klang {
 			items[count].max = max;
 			items[count].initial = initial;
 			items[count].size = size;
+			items[count].smoothing.reset(initial);
+			items[count].smoothed = initial;
 			items[count++].value = initial;
 		}
 
+		/// Start ramps for changed values (once per block)
+		void update() {
+			for (unsigned int c = 0; c < count; c++)
+				items[c].smoothing.set(items[c].value);
+		}
+
 		bool changed() {
 			bool changed = false;
 			for (unsigned int c = 0; c < count; c++) {
@@ -1242,6 +2690,33 @@ namespace klang {
 		//Control operator()(int index) const { return items[index]; }
 	};
 
+	/// Compact copy of control values, published once per block (e.g. by a synth for its voices)
+	struct Snapshot {
+		unsigned int count = 0;			///< number of controls
+		float value[128] = { 0 };		///< values for this block
+		float from[128] = { 0 };		///< values for the previous block (ramp from, across the block)
+		unsigned int changes[4] = {};	///< bitset of controls changed since the previous block
+
+		float operator[](int index) const { return value[index]; }
+		bool changed(int index) const { return changes[index >> 5] & (1u << (index & 31)); }
+		bool changed() const { return changes[0] | changes[1] | changes[2] | changes[3]; }
+
+		/// Copy the current control values, marking changes (returns true if any changed)
+		bool publish(const Controls& controls) {
+			const bool first = count != controls.count; // initial values (not changes)
+			count = controls.count;
+			changes[0] = changes[1] = changes[2] = changes[3] = 0;
+			for (unsigned int c = 0; c < count; c++) {
+				const float x = controls.items[c].value.value;
+				from[c] = first ? x : value[c];
+				if (x != value[c] && !first)
+					changes[c >> 5] |= 1u << (c & 31);
+				value[c] = x;
+			}
+			return changed();
+		}
+	};
+
 	typedef Array<float, 128> Values;
 
 	/// Factory preset
@@ -1260,14 +2735,21 @@ namespace klang {
 	//	return { Caption::from(name), values };
 	//}
 
-	/// Factory presets
-	struct Presets : Array<Preset, 128> {
+	/// Factory presets (allocated as added, rather than 128 fixed slots)
+	struct Presets {
+		std::vector<Preset> items;
+
+		unsigned int size() const { return (unsigned int)items.size(); }
+		Preset& operator[](int index) { return items[index]; }
+		const Preset& operator[](int index) const { return items[index]; }
+
 		void operator += (const Preset& preset) {
-			items[count++] = preset;
+			if (items.size() < 128)
+				items.push_back(preset);
 		}
 
 		void operator= (const Presets& presets) {
-			for (int p = 0; p < 128 && presets[p].name[0]; p++)
+			for (unsigned int p = 0; p < presets.size() && presets[p].name[0]; p++)
 				operator+=(presets[p]);
 		}
 
@@ -1278,16 +2760,80 @@ namespace klang {
 
 		template<typename... Values>
 		void add(const char* name, const Values... values) {
-			items[count].name = name;
+			Preset preset;
+			preset.name = name;
 
-			const float preset[] = { values... };
+			const float settings[] = { values... };
 			int nbValues = sizeof...(values);
 			for (int p = 0; p < nbValues; p++)
-				items[count].values.add(preset[p]);
-			count++;
+				preset.values.add(settings[p]);
+			operator+=(preset);
+		}
+	};
+
+	/// Aligned storage pool for owned buffers (64-byte aligned, power-of-two capacities; released blocks are recycled)
+	/// Not real-time safe: calls may allocate and take a lock, so size buffers outside the render.
+	struct Pool {
+		static constexpr size_t alignment = 64;
+
+		static float* allocate(unsigned int capacity) {
+#ifdef KLANG_TRAP_ALLOCATIONS
+			Realtime::allocated();
+#endif
+			const int index = bin(capacity);
+			std::lock_guard<std::mutex> lock(mutex());
+			Block*& head = blocks()[index];
+			if (head) {
+				Block* block = head;
+				head = block->next;
+				return (float*)block;
+			}
+			return (float*)::operator new(sizeof(float) << index, std::align_val_t(alignment));
+		}
+
+		static void release(float* samples, unsigned int capacity) {
+			if (!samples)
+				return;
+#ifdef KLANG_TRAP_ALLOCATIONS
+			Realtime::allocated();
+#endif
+			const int index = bin(capacity);
+			std::lock_guard<std::mutex> lock(mutex());
+			Block* block = (Block*)samples;
+			block->next = blocks()[index];
+			blocks()[index] = block;
+		}
+
+	private:
+		struct Block { Block* next; };
+
+		// size class (log2 of capacity; at least one 64-byte line)
+		static int bin(unsigned int capacity) {
+			int index = 4;
+			while ((1u << index) < capacity)
+				index++;
+			return index;
 		}
+
+		static std::mutex& mutex() { static std::mutex mutex; return mutex; }
+		static Block** blocks() { static Block* blocks[32] = { nullptr }; return blocks; }
+	};
+
+	/// Non-owning view of samples (pointer + length + stride; trivially copyable)
+	struct view {
+		signal* samples;
+		int length;
+		int stride;
+
+		signal& operator[](int index) { return samples[index * stride]; }
+		const signal& operator[](int index) const { return samples[index * stride]; }
+
+		// skip forward (e.g. by one block)
+		void advance(int count) { samples += count * stride; length -= count; }
 	};
 
+	IS_SIMPLE_TYPE(view)
+
 	/// Audio buffer (mono)
 	class buffer {
 	protected:
@@ -1323,21 +2869,40 @@ namespace klang {
 			set(initial);
 		}
 
-		buffer(int size, float initial = 0)
-			: mask(capacity(size) - 1), owned(true), samples(new float[capacity(size)]), size(size) {
+		buffer(int size = 1, float initial = 0)
+			: mask(capacity(size) - 1), owned(true), samples(Pool::allocate(capacity(size))), size(size) {
 			rewind();
 			set(initial);
 		}
 
-		virtual ~buffer() {
+		// contiguous view (non-owning)
+		buffer(const klang::view& view)
+			: owned(false), samples((float*)view.samples), size(view.length) {
+			assert(view.stride == 1);
+			rewind();
+		}
+
+		// copies of owned buffers get their own storage; others share samples
+		buffer(const buffer& in)
+			: mask(in.mask), owned(in.owned), samples(in.owned ? Pool::allocate(in.mask + 1) : in.samples), size(in.size) {
+			if (owned)
+				memcpy(samples, in.samples, sizeof(float) * size);
+			ptr = (signal*)samples + (in.ptr - (signal*)in.samples);
+			end = (signal*)samples + (in.end - (signal*)in.samples);
+		}
+
+		~buffer() {
 			if (owned)
-				delete[] samples;
+				Pool::release(samples, mask + 1);
+		}
+
+		void attach(const buffer& buffer, int size = 0) {
+			samples = buffer.samples;
+			rewind();
+			end = (signal*)&samples[size];
 		}
 
 		void rewind(int offset = 0) {
-#ifdef _MSC_VER
-			_controlfp_s(nullptr, _DN_FLUSH, _MCW_DN);
-#endif
 			ptr = (signal*)&samples[offset];
 			end = (signal*)&samples[size];
 		}
@@ -1418,8 +2983,7 @@ namespace klang {
 		}
 
 		buffer& operator=(const buffer& in) {
-			//assert(size == in.size);
-			memcpy(samples, in.samples, size * sizeof(float));
+			memcpy(samples, in.samples, min(size, in.size) * sizeof(float));
 			return *this;
 		}
 
@@ -1428,9 +2992,61 @@ namespace klang {
 			return *this;
 		}
 
+		float* data() { return samples; }
 		const float* data() const { return samples; }
+
+		// current sample onwards (for block processing)
+		signal* pointer() { return ptr; }
+		const signal* pointer() const { return ptr; }
+		int remaining() const { return int(end - ptr); }
+		operator klang::view() { return { ptr, remaining(), 1 }; }
 	};
 
+	namespace variable {
+		class buffer {
+			std::unique_ptr<klang::buffer> ptr;
+		public:
+			int size = 0;
+
+			buffer(int size = 1, float initial = 0.f) : size(size), ptr(new klang::buffer(size, initial)) {}
+			buffer(const klang::buffer& buffer) : size(buffer.size), ptr(new klang::buffer(buffer.size)) { *ptr = buffer; };
+			//buffer(klang::buffer* buffer) : size(buffer->size), ptr(new klang::buffer(buffer->data(), buffer->size)) { };
+			virtual ~buffer() { ptr.reset(); };
+
+			operator klang::buffer& () { return *ptr; }
+			operator const klang::buffer& () const { return *ptr; }
+			void resize(int size) {
+				if (size != ptr->size)
+					ptr = std::unique_ptr<klang::buffer>(new klang::buffer(buffer::size = size));
+			}
+
+			void rewind(int offset = 0) { ptr->rewind(offset); }
+			void clear() { ptr->clear(); }
+			void clear(int size) { ptr->clear(size); }	
+			int offset() const { return ptr->offset(); }
+			void set(float value = 0) { ptr->set(value); }
+			signal& operator[](int offset) { return ptr->operator[](offset); }
+			signal operator[](float offset) { return ptr->operator[](offset); }
+			signal operator[](float offset) const { return ptr->operator[](offset); }
+			const signal& operator[](int index) const { return ptr->operator[](index); }
+			operator signal& () { return ptr->operator signal & (); }
+			operator const signal& () const { return ptr->operator const signal & (); }
+			explicit operator double() const { return ptr->operator double(); }
+			bool finished() const { return ptr->finished(); }
+			signal& operator++(int) { return ptr->operator++(1); }
+			//signal& operator=(const signal& in) { return ptr->operator=(in); }
+			//signal& operator+=(const signal& in) { return ptr->operator+=(in); }
+			//signal& operator*=(const signal& in) { return ptr->operator*=(in); }
+			
+			variable::buffer& operator=(const klang::buffer& in) {
+				resize(in.size); *ptr = in; return *this;
+			}
+
+			float* data() { return ptr->data(); }
+			const float* data() const { return ptr->data(); }
+		};
+	}
+
 	struct Graph;
 	struct GraphPtr;
 
@@ -1447,8 +3063,8 @@ namespace klang {
 			virtual const SIGNAL& input() const { return in; }
 
 			// feedback input (include pre-processing, if any)
-			virtual void operator<<(const SIGNAL& source) { in = source; input(); }
-			virtual void input(const SIGNAL& source) { in = source; input(); }
+			virtual void operator<<(const SIGNAL& source) { in = source; this->input(); }
+			virtual void input(const SIGNAL& source) { in = source; this->input(); }
 
 		protected:
 			// preprocess input (default: none)
@@ -1465,17 +3081,17 @@ namespace klang {
 
 			// pass output to destination (with processing)
 			template<typename TYPE>
-			TYPE& operator>>(TYPE& destination) { process(); return destination = out; }
+			TYPE& operator>>(TYPE& destination) { this->process(); return destination = out; }
 
 			// returns output (with processing)
-			virtual operator const SIGNAL& () { process(); return out; } // return processed output
+			virtual operator const SIGNAL& () { this->process(); return out; } // return processed output
 			virtual operator const SIGNAL& () const { return out; } // return last output
 
 			// arithmetic operations produce copies
-			template<typename TYPE> SIGNAL operator+(TYPE& other) { process(); return out + SIGNAL(other); }
-			template<typename TYPE> SIGNAL operator*(TYPE& other) { process(); return out * SIGNAL(other); }
-			template<typename TYPE> SIGNAL operator-(TYPE& other) { process(); return out - SIGNAL(other); }
-			template<typename TYPE> SIGNAL operator/(TYPE& other) { process(); return out / SIGNAL(other); }
+			template<typename TYPE> SIGNAL operator+(TYPE& other) { this->process(); return out + SIGNAL(other); }
+			template<typename TYPE> SIGNAL operator*(TYPE& other) { this->process(); return out * SIGNAL(other); }
+			template<typename TYPE> SIGNAL operator-(TYPE& other) { this->process(); return out - SIGNAL(other); }
+			template<typename TYPE> SIGNAL operator/(TYPE& other) { this->process(); return out / SIGNAL(other); }
 
 			void reset() { out = 0; }
 
@@ -1518,9 +3134,17 @@ namespace klang {
 
 			using Output<SIGNAL>::operator>>;
 			using Output<SIGNAL>::process;
-			operator const SIGNAL& () override { process(); return out; } // return processed output		
+			operator const SIGNAL& () override { this->process(); return out; } // return processed output		
 			operator const SIGNAL& () const override { return out; } // return last output		
 
+			// block processing (default: per-sample; override with a tight loop)
+			virtual void process(SIGNAL* output, int length) {
+				for (int s = 0; s < length; s++) {
+					this->process();
+					output[s] = out;
+				}
+			}
+
 		protected:
 			// overrideable parameter setting (up to 8 parameters)
 			/// @cond
@@ -1552,12 +3176,21 @@ namespace klang {
 			virtual ~Modifier() {}
 
 			// signal processing (input-output)
-			operator const SIGNAL& () override { process(); return out; } // return processed output
+			operator const SIGNAL& () override { this->process(); return out; } // return processed output
 			operator const SIGNAL& () const override { return out; } // return last output
 
 			using Input<SIGNAL>::input;
 			virtual void process() override { out = in; } // default to pass-through
 
+			// block processing (default: per-sample; override with a tight loop; supports input == output)
+			virtual void process(const SIGNAL* input, SIGNAL* output, int length) {
+				for (int s = 0; s < length; s++) {
+					this->input(input[s]);
+					this->process();
+					output[s] = out;
+				}
+			}
+
 			// inline parameter(s) support
 			template<typename... params>
 			Modifier<SIGNAL>& operator()(params... p) {
@@ -1596,7 +3229,7 @@ namespace klang {
 			operator SIGNAL() {
 				if (function)
 					return out = evaluate();
-				process();
+				this->process();
 				return out;
 			};
 			operator param() {
@@ -2150,12 +3783,12 @@ namespace klang {
 
 	/// @cond
 	template <typename TYPE, typename SIGNAL>
-	using GeneratorOrModifier = typename std::conditional<std::is_base_of<Generator, TYPE>::value, Generic::Generator<SIGNAL>,
-		typename std::conditional<std::is_base_of<Modifier, TYPE>::value, Generic::Modifier<SIGNAL>, void>::type>::type;
+	using GeneratorOrModifier = typename std::conditional<std::is_base_of<Generic::Generator<signal>, TYPE>::value, Generic::Generator<SIGNAL>,
+		typename std::conditional<std::is_base_of<Generic::Modifier<signal>, TYPE>::value, Generic::Modifier<SIGNAL>, void>::type>::type;
 	/// @endcond
 
 	/// A parallel bank of multiple audio objects
-	template<typename TYPE, int COUNT>
+	template<typename TYPE, int COUNT, typename = void>
 	struct Bank : public GeneratorOrModifier<TYPE, signals<COUNT>> {
 		using GeneratorOrModifier<TYPE, signals<COUNT>>::in;
 		using GeneratorOrModifier<TYPE, signals<COUNT>>::out;
@@ -2316,14 +3949,24 @@ namespace klang {
 		return *this;
 	}
 
+	/// Stateless function of a signal (e.g. f(x), x >> f >> y, or a fused expression stage; safe on any thread)
+	template<class FUNCTION>
+	struct Mapping {
+		FUNCTION function;
+		constexpr Mapping(FUNCTION function) : function(function) {}
+
+		template<typename TYPE>
+		float operator()(TYPE&& x) const { const signal value = x; return function(value.value); }
+	};
+
 	/// Square root function (audio object)
-	inline static Function<float> sqrt(SQRTF);
+	constexpr Mapping sqrt{ [](float x) -> float { return SQRTF(x); } };
 	/// Absolute/rectify function (audio object)
-	inline static Function<float> abs(FABS);
+	constexpr Mapping abs{ [](float x) -> float { return FABS(x); } };
 	/// Square function (audio object)
-	inline static Function<float> sqr([](float x) -> float { return x * x; });
+	constexpr Mapping sqr{ [](float x) -> float { return x * x; } };
 	/// Cube function (audio object)
-	inline static Function<float> cube([](float x) -> float { return x * x * x; });
+	constexpr Mapping cube{ [](float x) -> float { return x * x * x; } };
 
 #define sqrt klang::sqrt // avoid conflict with std::sqrt
 #define abs klang::abs   // avoid conflict with std::abs
@@ -2634,7 +4277,7 @@ namespace klang {
 		}
 	};
 
-	/// Audio delay object
+	/// Audio delay object (fixed size)
 	template<int SIZE>
 	struct Delay : public Modifier {
 		using Modifier::in;
@@ -2666,20 +4309,6 @@ namespace klang {
 			return buffer[read];
 		}
 
-		//signal tap(float delay) const {
-		//	float read = (float)(position - 1) - delay;
-		//	if (read < 0.f)
-		//		read += SIZE;
-
-		//	const float f = floor(read);
-		//	const float fraction = read - f;
-
-		//	const int i = (int)read;
-		//	const int j = (i + 1) % SIZE;
-
-		//	return buffer[i] + fraction * (buffer[j] - buffer[i]);
-		//}
-
 		signal tap(float delay) const {
 			// Calculate the read position
 			float read = static_cast<float>(position - 1) - delay;
@@ -2697,6 +4326,38 @@ namespace klang {
 			return buffer[i] + fraction * (buffer[j] - buffer[i]);
 		}
 
+		signal lagrange(float delay) const {
+			// Calculate the read position
+			float read = static_cast<float>(position - 1) - delay;
+			if (read < 0.f)
+				read += SIZE;
+
+			// Separate integer and fractional parts
+			int i = static_cast<int>(read);  // Integer part
+			float x = read - i;              // Fractional part (0 ? x < 1)
+
+			// Get four surrounding indices using modulo for circular buffer
+			int i0 = (i - 1 + SIZE) % SIZE;
+			int i1 = i;                      // Main sample
+			int i2 = (i + 1) % SIZE;
+			int i3 = (i + 2) % SIZE;
+
+			// Read corresponding samples
+			float y0 = buffer[i0];
+			float y1 = buffer[i1];
+			float y2 = buffer[i2];
+			float y3 = buffer[i3];
+
+			// Compute Lagrange interpolation (third-order)
+			float c0 = (-x * (x - 1) * (x - 2)) / 6.0f;
+			float c1 = ((x + 1) * (x - 1) * (x - 2)) / 2.0f;
+			float c2 = (-x * (x + 1) * (x - 2)) / 2.0f;
+			float c3 = (x * (x + 1) * (x - 1)) / 6.0f;
+
+			return c0 * y0 + c1 * y1 + c2 * y2 + c3 * y3;
+		}
+
+
 		signal tap() const {
 			// Use modulo to get the next index without branching
 			const int i = last.position;
@@ -2711,10 +4372,26 @@ namespace klang {
 			last.position = (last.position + 1) % SIZE;
 		}
 
-		//Delay<SIZE>& operator++(int) {
-		//	last.position++;
-		//	return *this;
-		//}
+		virtual void process(const signal* input, signal* output, int length) override {
+			float* const samples = buffer.data();
+			int write = position, read = last.position;
+			const float fraction = last.fraction;
+			for (int s = 0; s < length; s++) {
+				samples[write] = input[s];
+				if (++write == SIZE)
+					write = 0;
+				const int next = (read + 1 == SIZE) ? 0 : (read + 1);
+				output[s] = samples[read] + fraction * (samples[next] - samples[read]);
+				read = next;
+			}
+			position = write;
+			last.position = read;
+			buffer.rewind(position);
+			if (length > 0) {
+				in = input[length - 1];
+				out = output[length - 1];
+			}
+		}
 
 		struct Tap {
 			int position;
@@ -2755,103 +4432,520 @@ namespace klang {
 		unsigned int max() const { return SIZE; }
 	};
 
-	/// Wavetable-based oscillator
-	class Wavetable : public Oscillator {
-		using Oscillator::set;
-	protected:
-		buffer buffer;
-		const int size;
-	public:
-		Wavetable(int size = 2048) : buffer(size), size(size) {}
+	/// Audio delay object (resizable)
+	template<>
+	struct Delay<0> : public Modifier {
+		using Modifier::in;
+		using Modifier::out;
 
-		template<typename TYPE>
-		Wavetable(TYPE oscillator, int size = 2048) : buffer(size), size(size) {
-			operator=(oscillator);
+		buffer* buffer;
+		float time = 1;
+		int position = 0;
+		int SIZE = 0;
+		int capacity = 0;
+
+		Delay() : buffer(new klang::buffer(1, 0)) { clear(); }
+		Delay(const Delay&) = delete;
+		Delay& operator=(const Delay&) = delete;
+		virtual ~Delay() { delete buffer; }
+
+		void clear() {
+			buffer->clear();
 		}
 
-		signal& operator[](int index) {
-			return buffer[index];
+		// preallocate for delays of up to the given length (e.g. in setup)
+		void reserve(int samples) {
+			if (samples > capacity) {
+				capacity = samples;
+				klang::buffer* new_buffer = new klang::buffer(capacity + 1, 0);
+				std::swap(buffer, new_buffer);
+				delete new_buffer;
+				position = 0;
+			}
 		}
 
-		template<typename TYPE>
-		Wavetable& operator=(TYPE& oscillator) {
-			oscillator.set(fs / size);
-			for (int s = 0; s < size; s++)
-				buffer[s] = oscillator;
-			return *this;
+		// change length (only allocates if beyond reserved capacity)
+		void resize(int samples) {
+			if (samples != SIZE) {
+				reserve(samples);
+				SIZE = samples;
+				clear();
+				buffer->rewind();
+				position = 0;
+			}
 		}
 
-		virtual void set(param frequency) override {
-			Oscillator::frequency = frequency;
-			increment = frequency * (size / fs);
+		void input() override {
+			(*buffer)++ = in;
+			position++;
+			if (position == SIZE) {
+				buffer->rewind();
+				position = 0;
+			}
 		}
 
-		virtual void set(param frequency, param phase) override {
-			position = phase * float(size);
-			set(frequency);
+		signal tap(int delay) const {
+			int read = (position - 1) - delay;
+			if (read < 0)
+				read += SIZE;
+			return (*buffer)[read];
 		}
 
-		virtual void set(relative phase) override {
+		signal tap(float delay) const {
+			// Calculate the read position
+			float read = static_cast<float>(position - 1) - delay;
+			if (read < 0.f)
+				read += SIZE;
 
-			offset = phase * float(size);
+			// Separate integer and fractional parts
+			const int i = static_cast<int>(read);  // Integer part
+			const float fraction = read - i;       // Fractional part
+
+			// Use modulo to get the next index without branching
+			const int j = (i + 1) % SIZE;          // Next index in circular buffer
+
+			// Linear interpolation: buffer[i] + fraction * (buffer[j] - buffer[i])
+			return (*buffer)[i] + fraction * ((*buffer)[j] - (*buffer)[i]);
 		}
 
-		virtual void set(param frequency, relative phase) override {
-			set(frequency);
-			set(phase);
+		signal tap() const {
+			// Use modulo to get the next index without branching
+			const int i = last.position;
+			const int j = (i + 1) % SIZE;          // Next index in circular buffer
+
+			// Linear interpolation: buffer[i] + fraction * (buffer[j] - buffer[i])
+			return (*buffer)[i] + last.fraction * ((*buffer)[j] - (*buffer)[i]);
 		}
 
-		void process() override {
-			position += { increment, size };
-			out = buffer[position + offset /*klang::increment(offset, size)*/];
+		virtual void process() override {
+			out = tap();
+			last.position = (last.position + 1) % SIZE;
 		}
-	};
 
-	/// Envelope object
-	class Envelope : public Generator {
-		using Generator::set;
+		virtual void process(const signal* input, signal* output, int length) override {
+			if (!SIZE)
+				return Modifier::process(input, output, length);
+			float* const samples = buffer->data();
+			int write = position, read = last.position;
+			const float fraction = last.fraction;
+			for (int s = 0; s < length; s++) {
+				samples[write] = input[s];
+				if (++write == SIZE)
+					write = 0;
+				const int next = (read + 1 == SIZE) ? 0 : (read + 1);
+				output[s] = samples[read] + fraction * (samples[next] - samples[read]);
+				read = next;
+			}
+			position = write;
+			last.position = read;
+			buffer->rewind(position);
+			if (length > 0) {
+				in = input[length - 1];
+				out = output[length - 1];
+			}
+		}
 
-	public:
+		struct Tap {
+			int position;
+			float fraction;
+		} last;
 
-		struct Follower;
+		virtual void set(param samples) override {
+			time = samples < SIZE ? (float)samples : SIZE;
 
-		/// Abstract envelope ramp type
-		struct Ramp : public Generator {
-			float target;
-			float rate;
-			bool active = false;
-		public:
+			float read = static_cast<float>(position - 1) - time;
+			if (read < 0.f)
+				read += SIZE;
 
-			// Create a null ramp (full signal)
-			Ramp(float value = 1.f) {
-				setValue(value);
-			}
+			last.position = static_cast<int>(read);  // Integer part
+			last.fraction = read - last.position;	 // Fractional part
+		}
 
-			// Create a ramp from start to target over time (in seconds)
-			Ramp(float start, float target, float time) {
-				setValue(start);
-				setTarget(target);
-				setTime(time);
-			}
+		template<typename TIME>
+		signal operator()(TIME& delay) {
+			if constexpr (std::is_integral_v<TIME>)
+				return tap((int)delay);
+			else if constexpr (std::is_floating_point_v<TIME>)
+				return tap((float)delay);
+			else
+				return tap((signal)delay);
+		}
 
-			virtual ~Ramp() {}
+		template<typename TIME>
+		signal operator()(const TIME& delay) {
+			if constexpr (std::is_integral_v<TIME>)
+				return tap((int)delay);
+			else if constexpr (std::is_floating_point_v<TIME>)
+				return tap((float)delay);
+			else
+				return tap((signal)delay);
+		}
 
-			// Is ramp currently processing (ramping)?
-			bool isActive() const {
-				return active;
-			}
+		unsigned int max() const { return SIZE; }
+	};
 
-			// Set a new target (retains rate)
-			virtual void setTarget(float target) {
-				Ramp::target = target;
-				active = (out != target);
-			}
+	/// Band-limited wavetable, one level per octave (immutable once built; see Mipmap::shared)
+	struct Mipmap {
+		const int size;		///< samples per cycle (power of two)
+		const int levels;	///< octave levels (level l keeps harmonics below (size / 2) >> l)
 
-			// Immediately jump to value (disables ramp)
-			virtual void setValue(float value) {
-				out = value;
-				Ramp::target = value;
-				active = false;
+		/// Silent table
+		Mipmap(int size = 2048) : size(size), levels(1), samples(size + guard, 0.f) {}
+
+		/// Table from one cycle of an oscillator (builds every level; not real-time)
+		template<typename TYPE>
+		Mipmap(TYPE& oscillator, int size = 2048) : size(size), levels(count(size)), samples(levels * (size + guard), 0.f) {
+			std::vector<float> cycle(size);
+			oscillator.set(fs / size);
+			for (int s = 0; s < size; s++) {
+				const signal sample = oscillator;
+				cycle[s] = sample;
+			}
+			build(cycle.data());
+		}
+
+		/// Samples for level l (with guard samples wrapped around at [-1], [size] and [size + 1] for interpolation)
+		const float* level(int l) const { return samples.data() + l * (size + guard) + 1; }
+
+		/// Fractional level for a frequency (harmonics in both neighbouring levels stay below nyquist)
+		float select(float frequency) const {
+			const float harmonics = fs.nyquist / (frequency > 0.f ? frequency : -frequency);
+			const float x = log2f((size / 2) / harmonics) + 1.f;
+			return x < 0.f ? 0.f : x > levels - 1 ? float(levels - 1) : x;
+		}
+
+		/// Table for the waveform of TYPE (built on first use; shared while in use)
+		template<typename TYPE>
+		static std::shared_ptr<const Mipmap> shared(int size = 2048) {
+			static std::mutex mutex;
+			static std::vector<std::weak_ptr<const Mipmap>> tables;
+			std::lock_guard<std::mutex> lock(mutex);
+			// drop tables no longer in use
+			tables.erase(std::remove_if(tables.begin(), tables.end(), [](const auto& table) { return table.expired(); }), tables.end());
+			for (auto& table : tables)
+				if (auto existing = table.lock(); existing && existing->size == size)
+					return existing;
+			TYPE oscillator;
+			auto table = std::make_shared<const Mipmap>(oscillator, size);
+			tables.push_back(table);
+			return table;
+		}
+
+	protected:
+		static constexpr int guard = 3;
+		std::vector<float> samples;
+
+		static int count(int size) {
+			int levels = 1;
+			while (((size / 2) >> levels) >= 1)
+				levels++;
+			return levels;
+		}
+
+		// resynthesise each level from the cycle's harmonics (DFT)
+		void build(const float* cycle) {
+			const int harmonics = size / 2;
+			std::vector<double> cosine(size), re(harmonics, 0.0), im(harmonics, 0.0);
+			for (int s = 0; s < size; s++)
+				cosine[s] = cos(2.0 * pi.d * s / size);
+			for (int h = 0; h < harmonics; h++) {
+				for (int s = 0; s < size; s++) {
+					const int i = (h * s) & (size - 1);
+					re[h] += cycle[s] * cosine[i];
+					im[h] += cycle[s] * cosine[(i + size - size / 4) & (size - 1)]; // sine
+				}
+				re[h] *= h ? 2.0 / size : 1.0 / size;
+				im[h] *= 2.0 / size;
+			}
+			for (int l = 0; l < levels; l++) {
+				float* out = samples.data() + l * (size + guard) + 1;
+				const int top = harmonics >> l;
+				for (int s = 0; s < size; s++) {
+					double x = re[0];
+					for (int h = 1; h < top; h++) {
+						const int i = (h * s) & (size - 1);
+						x += re[h] * cosine[i] + im[h] * cosine[(i + size - size / 4) & (size - 1)];
+					}
+					out[s] = (float)x;
+				}
+				out[-1] = out[size - 1];
+				out[size] = out[0];
+				out[size + 1] = out[1];
+			}
+		}
+	};
+
+	/// Wavetable interpolation (selected at compile time; see WavetableOscillator)
+	enum class Interpolation {
+		None,		// nearest (truncated) sample
+		Linear,		// 2-point, linear
+		Hermite,	// 4-point, 3rd-order Hermite (Catmull-Rom)
+		Lagrange,	// 4-point, 3rd-order Lagrange
+	};
+
+	/// Wavetable-based oscillator (band-limited; levels crossfade with frequency)
+	template<Interpolation INTERPOLATION = Interpolation::Linear>
+	class WavetableOscillator : public Oscillator {
+		using Oscillator::set;
+	protected:
+		std::shared_ptr<const Mipmap> table;
+		const int size;
+		const float* lower = nullptr;	// level for the current frequency
+		const float* upper = nullptr;	// next (duller) level
+		float blend = 0.f;				// crossfade to upper
+
+		// interpolated sample at index [0, size) from a level (guard samples cover i - 1 .. i + 2)
+		static float read(const float* level, float index) {
+			const int i = (int)index;
+			const float f = index - i;
+			const float* y = level + i;
+			if constexpr (INTERPOLATION == Interpolation::None) {
+				return y[0];
+			} else if constexpr (INTERPOLATION == Interpolation::Linear) {
+				return y[0] + f * (y[1] - y[0]);
+			} else if constexpr (INTERPOLATION == Interpolation::Hermite) {
+				const float c1 = 0.5f * (y[1] - y[-1]);
+				const float c2 = y[-1] - 2.5f * y[0] + 2.f * y[1] - 0.5f * y[2];
+				const float c3 = 0.5f * (y[2] - y[-1]) + 1.5f * (y[0] - y[1]);
+				return ((c3 * f + c2) * f + c1) * f + y[0];
+			} else {
+				const float fm1 = f - 1.f, fm2 = f - 2.f, fp1 = f + 1.f;
+				return (-f * fm1 * fm2 * y[-1] + fp1 * f * fm1 * y[2]) * (1.f / 6.f)
+					+ (fp1 * fm1 * fm2 * y[0] - fp1 * f * fm2 * y[1]) * 0.5f;
+			}
+		}
+
+		// wrap a phase index [0, size + size) into [0, size) (no branch)
+		float wrap(float index) const { return index - (index >= size ? (float)size : 0.f); }
+
+		float read(float index) const {
+			index = wrap(index);
+			const float a = read(lower, index);
+			return blend > 0.f ? a + blend * (read(upper, index) - a) : a;
+		}
+
+		// render from phase indices [0, size) (vectorisable; crossfade applied when set)
+		void render(const float* index, signal* output, int length) const {
+			float* const out = (float*)output;
+			for (int s = 0; s < length; s++)
+				out[s] = read(lower, index[s]);
+			if (blend > 0.f) {
+				for (int s = 0; s < length; s++)
+					out[s] += blend * (read(upper, index[s]) - out[s]);
+			}
+		}
+
+		// pick the levels for a frequency
+		void select(float frequency) {
+			const float level = table->select(frequency);
+			const int l = (int)level;
+			lower = table->level(l);
+			upper = table->level(l + 1 < table->levels ? l + 1 : l);
+			blend = level - l;
+		}
+
+	public:
+		WavetableOscillator(int size = 2048) : table(std::make_shared<const Mipmap>(size)), size(size) { set(frequency); }
+		WavetableOscillator(std::shared_ptr<const Mipmap> table) : table(table), size(table->size) { set(frequency); }
+
+		template<typename TYPE>
+		WavetableOscillator(TYPE oscillator, int size = 2048) : size(size) {
+			operator=(oscillator);
+		}
+
+		signal operator[](int index) const {
+			return table->level(0)[index];
+		}
+
+		/// Build a table from one cycle of an oscillator (not real-time)
+		template<typename TYPE>
+		WavetableOscillator& operator=(TYPE& oscillator) {
+			return operator=(std::make_shared<const Mipmap>(oscillator, size));
+		}
+
+		/// Use a (shared) table of the same size
+		WavetableOscillator& operator=(std::shared_ptr<const Mipmap> table) {
+			assert(table->size == size);
+			WavetableOscillator::table = table;
+			set(frequency);
+			return *this;
+		}
+
+		virtual void set(param frequency) override {
+			Oscillator::frequency = frequency;
+			increment = frequency * (size / fs);
+			select(frequency);
+		}
+
+		virtual void set(param frequency, param phase) override {
+			position = phase * float(size);
+			set(frequency);
+		}
+
+		virtual void set(relative phase) override {
+
+			offset = phase * float(size);
+		}
+
+		virtual void set(param frequency, relative phase) override {
+			set(frequency);
+			set(phase);
+		}
+
+		void process() override {
+			if (increment.value < size) { // (as Phase: no advance otherwise; wraps at size, as the block paths)
+				position.value += increment.value;
+				position.value -= position.value >= size ? (float)size : 0.f;
+			}
+			out = read(position + offset /*klang::increment(offset, size)*/);
+		}
+
+		/// Render a block at the current frequency
+		void process(signal* output, int length) override {
+			if (increment.value >= size) { // (as Phase: no advance)
+				for (int s = 0; s < length; s++)
+					output[s] = read(position + offset);
+			} else {
+				float index[KLANG_BLOCK_SIZE];
+				float p = position.value;
+				const float step = increment.value, phase = offset.value;
+				for (int start = 0; start < length; start += KLANG_BLOCK_SIZE) {
+					const int n = min(KLANG_BLOCK_SIZE, length - start);
+					for (int s = 0; s < n; s++) {
+						p += step;
+						p -= p >= size ? (float)size : 0.f;
+						index[s] = wrap(p + phase);
+					}
+					render(index, output + start, n);
+				}
+				position.value = p;
+			}
+			if (length > 0) out = output[length - 1];
+		}
+
+		/// Render a block with per-sample frequency (in Hz; levels chosen for the block's highest frequency)
+		void process(const float* frequency, signal* output, int length) {
+			float highest = 0.f;
+			for (int s = 0; s < length; s++) {
+				const float f = frequency[s] < 0.f ? -frequency[s] : frequency[s];
+				highest = f > highest ? f : highest;
+			}
+			select(highest);
+
+			float index[KLANG_BLOCK_SIZE];
+			float p = position.value;
+			const float scale = size / fs, phase = offset.value;
+			for (int start = 0; start < length; start += KLANG_BLOCK_SIZE) {
+				const int n = min(KLANG_BLOCK_SIZE, length - start);
+				for (int s = 0; s < n; s++) {
+					p += frequency[start + s] * scale;
+					p -= p >= size ? (float)size : 0.f;
+					p += p < 0.f ? (float)size : 0.f;
+					index[s] = wrap(p + phase);
+				}
+				render(index, output + start, n);
+			}
+			position.value = p;
+			if (length > 0) {
+				Oscillator::frequency = frequency[length - 1];
+				increment = Oscillator::frequency * scale;
+				out = output[length - 1];
+			}
+		}
+	};
+
+	/// Wavetable-based oscillator (linear interpolation)
+	using Wavetable = WavetableOscillator<>;
+
+	/// Sample-based signal generator
+	class Sample : public Oscillator {
+		using Oscillator::set;
+	protected:
+		buffer buffer;
+		int size;
+	public:
+		Sample() : buffer(nullptr, 0), size(0) { }
+
+		signal& operator[](int index) {
+			return buffer[index];
+		}
+
+		Sample& operator=(const klang::buffer& buffer) {
+			size = buffer.size;
+			Sample::buffer.attach(buffer, size);
+			return *this;
+		}
+
+		virtual void set(param frequency) override {
+			Oscillator::frequency = frequency;
+			increment = 1;// frequency* (44100 / fs);
+		}
+
+		virtual void set(param frequency, param phase) override {
+			position = phase * float(44100);
+			set(frequency);
+		}
+
+		virtual void set(relative phase) override {
+			offset = phase * float(44100);
+		}
+
+		virtual void set(param frequency, relative phase) override {
+			set(frequency);
+			set(phase);
+		}
+
+		void process() override {
+			position += { increment, size };
+			out = buffer[position + offset];
+		}
+	};
+
+	/// Envelope object
+	class Envelope : public Generator {
+		using Generator::set;
+
+	public:
+
+		struct Follower;
+
+		/// Abstract envelope ramp type
+		struct Ramp : public Generator {
+			float target;
+			float rate;
+			bool active = false;
+		public:
+
+			// Create a null ramp (full signal)
+			Ramp(float value = 1.f) {
+				setValue(value);
+			}
+
+			// Create a ramp from start to target over time (in seconds)
+			Ramp(float start, float target, float time) {
+				setValue(start);
+				setTarget(target);
+				setTime(time);
+			}
+
+			virtual ~Ramp() {}
+
+			// Is ramp currently processing (ramping)?
+			bool isActive() const {
+				return active;
+			}
+
+			// Set a new target (retains rate)
+			virtual void setTarget(float target) {
+				Ramp::target = target;
+				active = (out != target);
+			}
+
+			// Immediately jump to value (disables ramp)
+			virtual void setValue(float value) {
+				out = value;
+				Ramp::target = value;
+				active = false;
 			}
 
 			// Set rate of change (per sample)
@@ -2952,16 +5046,16 @@ namespace klang {
 		};
 
 		// Default Envelope (full signal)
-		Envelope() : ramp(new Linear()) { set(Points(0.f, 1.f)); }
+		Envelope() : ramp(new Linear()) { Envelope::points.reserve(8); set(Points(0.f, 1.f)); }
 
 		// Creates a new envelope from a list of points, e.g. Envelope env = Envelope::Points(0,1)(1,0);
-		Envelope(const Points& points) : ramp(new Linear()) { set(points); }
+		Envelope(const Points& points) : ramp(new Linear()) { Envelope::points.reserve(8); set(points); }
 
 		// Creates a new envelope from a list of points, e.g. Envelope env = { { 0,1 }, { 1,0 } };
-		Envelope(std::initializer_list<Point> points) : ramp(new Linear()) { set(points); }
+		Envelope(std::initializer_list<Point> points) : ramp(new Linear()) { Envelope::points.reserve(8); set(points); }
 
 		// Creates a copy of an envelope from another envelope
-		Envelope(const Envelope& in) : ramp(new Linear()) { set(in.points); }
+		Envelope(const Envelope& in) : ramp(new Linear()) { Envelope::points.reserve(8); set(in.points); }
 
 		virtual ~Envelope() {}
 
@@ -2983,6 +5077,12 @@ namespace klang {
 			initialise();
 		}
 
+		// Sets the envelope from a list of points (reusing storage), e.g. env.set({ { 0,1 }, { 1,0 } });
+		void set(std::initializer_list<Point> points) {
+			Envelope::points.assign(points);
+			initialise();
+		}
+
 		// Sets the envelope from a list of points, e.g. env.set( Envelope::Points(0,1)(1,0) );
 		void set(const Points& point) {
 			points.clear();
@@ -3099,7 +5199,7 @@ namespace klang {
 
 		// Returns the output of the envelope and advances the envelope (for backwards compatibility)
 		signal& operator++(int) {
-			process();
+			this->process();
 			return out;
 		}
 
@@ -3138,6 +5238,29 @@ namespace klang {
 			}
 		}
 
+		void process(signal* output, int length) {
+			if (length > 0 && !ramp->isActive()) {
+				if (stage == Off) { // finished => constant output
+					out = ramp->out;
+					for (int s = 0; s < length; s++)
+						output[s] = out;
+					return;
+				}
+				if (stage == Sustain && loop.isActive() && loop.start == loop.end && point == loop.start) { // sustain point => constant output
+					output[0] = out = ramp->out;
+					ramp->setValue(points[point].y);
+					for (int s = 1; s < length; s++)
+						output[s] = out = ramp->out;
+					time += timeInc * length;
+					return;
+				}
+			}
+			for (int s = 0; s < length; s++) {
+				Envelope::process();
+				output[s] = out;
+			}
+		}
+
 		// Retrieve a specified envelope point (read-only)
 		const Point& operator[](int point) const {
 			return points[point];
@@ -3267,41 +5390,370 @@ namespace klang {
 		return carrier;
 	}
 
+	/// Timestamped plugin event (sample offset into the next render call)
+	struct Event {
+		enum Type : unsigned char { MIDI, Control, Preset } type;
+		int offset;
+		union {
+			struct { unsigned char status, byte1, byte2; } midi;
+			struct { int index; float value; } control;
+			int preset;
+		};
+	};
+
+	/// Event queue (fixed capacity; time ordered, equal offsets kept in arrival order; fill from the audio thread)
+	struct Events {
+		static constexpr int capacity = 512;
+		int quantum = 1; ///< offset resolution in samples (1 = sample-accurate; larger merges nearby events into fewer sub-blocks; below 1 acts as 1)
+
+		unsigned int size() const { return count; }
+		const Event& operator[](int index) const { return items[index]; }
+		void clear() { count = 0; }
+
+		bool add(const Event& event) {
+			if (count == capacity)
+				return false;
+			int i = count++;
+			for (; i > 0 && items[i - 1].offset > event.offset; i--)
+				items[i] = items[i - 1];
+			items[i] = event;
+			return true;
+		}
+
+		bool midi(int offset, int status, int byte1, int byte2) {
+			Event event = {};
+			event.type = Event::MIDI;
+			event.offset = offset;
+			event.midi = { (unsigned char)status, (unsigned char)byte1, (unsigned char)byte2 };
+			return add(event);
+		}
+
+		bool control(int offset, int index, float value) {
+			Event event = {};
+			event.type = Event::Control;
+			event.offset = offset;
+			event.control = { index, value };
+			return add(event);
+		}
+
+		bool preset(int offset, int index) {
+			Event event = {};
+			event.type = Event::Preset;
+			event.offset = offset;
+			event.preset = index;
+			return add(event);
+		}
+
+	protected:
+		Event items[capacity];
+		unsigned int count = 0;
+		friend struct Plugin;
+	};
+
+	/// Silence detector (opt-in: set a threshold; silent once the block peak stays below it for the hold time)
+	struct Silence {
+		float threshold = 0.f;	///< peak level treated as silence (0 = disabled)
+		float hold = 0.1f;		///< seconds below the threshold before silent
+		float declared = 0.f;	///< tail known upfront (seconds; e.g. a reverb's decay), reported until a longer one is seen
+
+		bool enabled() const { return threshold > 0.f; }
+		bool silent() const { return enabled() && quiet >= hold * fs; }
+
+		/// Tail length in seconds (declared, or the longest output seen after the input stopped plus the hold time)
+		float tail() const { return std::max(declared, enabled() ? longest * fs.inv + hold : 0.f); }
+
+		// peak level of a block
+		static float peak(const float* samples, int length, int stride = 1) {
+			float peak = 0.f;
+			for (int s = 0; s < length * stride; s += stride) {
+				const float x = samples[s] < 0.f ? -samples[s] : samples[s];
+				peak = x > peak ? x : peak;
+			}
+			return peak;
+		}
+
+		// block peaks above the threshold
+		bool loud(const float* samples, int length, int stride = 1) const { return peak(samples, length, stride) > threshold; }
+
+		// track a block, given whether its input and output were loud
+		void update(bool input, bool output, int length) {
+			if (input) {
+				quiet = ring = 0;
+			} else if (output) {
+				quiet = 0;
+				ring += length;
+				longest = ring > longest ? ring : longest;
+			} else {
+				quiet += length;
+				ring += length;
+			}
+		}
+
+		void reset() { quiet = ring = 0; }
+
+	protected:
+		int quiet = 0;		// samples below the threshold
+		int ring = 0;		// samples since the input stopped
+		int longest = 0;	// longest ring seen
+	};
+
 	/// Base class for UI / MIDI controll
 	struct Controller {
 	protected:
 		virtual event control(int index, float value) {};
 		virtual event preset(int index) {};
 		virtual event midi(int status, int byte1, int byte2) {};
+		virtual event setup() {};	// size / allocate for the sample rate and block size (not real-time)
+		virtual event restart() {};	// clear state before (re)starting audio
 	public:
 		virtual void onControl(int index, float value) { control(index, value); };
 		virtual void onPreset(int index) { preset(index); };
 		virtual void onMIDI(int status, int byte1, int byte2) { midi(status, byte1, byte2); }
+		virtual void onSetup() { setup(); }
+		virtual void onRestart() { restart(); }
 	};
 
 	/// Base class for mini-plugin
 	struct Plugin : public Controller {
+		Plugin() { Random::number(1); } // members' default random streams are numbered per instance
 		virtual ~Plugin() {}
 
 		Controls controls;
 		Presets presets;
+		Context context; ///< processing context (sample rate, max block size)
+		Events events;   ///< timestamped events, applied at their offset within the next render
+
+		/// Apply parameter changes posted to controls.exchange (audio thread; notifies real changes only)
+		void receive() {
+			controls.exchange.drain([this](int index, float value) {
+				if (controls[index].value != std::clamp(value, controls[index].min, controls[index].max)) {
+					controls[index].set(value);
+					onControl(index, controls[index].value);
+				}
+			});
+		}
+
+		/// Apply a queued event (see Events)
+		virtual void dispatch(const Event& event) {
+			switch (event.type) {
+			case Event::MIDI:
+				onMIDI(event.midi.status, event.midi.byte1, event.midi.byte2);
+				break;
+			case Event::Control:
+				if (event.control.index >= 0 && event.control.index < (int)controls.size()) {
+					controls[event.control.index].set(event.control.value);
+					onControl(event.control.index, controls[event.control.index].value);
+				}
+				break;
+			case Event::Preset:
+				onPreset(event.preset);
+				break;
+			}
+		}
+
+		/// Render length samples as sub-blocks split at queued event offsets, via render(offset, length) (later events carry over)
+		template<typename RENDER>
+		void split(int length, RENDER render) {
+			if (splitting) { // nested (e.g. synth post-processing): the caller owns the events
+				render(0, length);
+				return;
+			}
+			splitting = true;
+			controls.update();
+
+			const int quantum = std::max(1, events.quantum);
+			int offset = 0;
+			unsigned int e = 0;
+			while (e < events.count) {
+				int at = events.items[e].offset;
+				at -= at % quantum;
+				if (at >= length)
+					break;
+				if (at > offset) {
+					render(offset, at - offset);
+					offset = at;
+				}
+				dispatch(events.items[e++]);
+				if (e == events.count || events.items[e].offset - events.items[e].offset % quantum > offset)
+					controls.update(); // start ramps once per sub-block
+			}
+			if (offset < length)
+				render(offset, length - offset);
+
+			// keep later events (relative to the next call)
+			unsigned int kept = 0;
+			for (; e < events.count; e++) {
+				events.items[kept] = events.items[e];
+				events.items[kept++].offset -= length;
+			}
+			events.count = kept;
+			splitting = false;
+		}
+
+		/// Set the host sample rate and maximum block size, then setup and restart (call before processing)
+		/// Constructors are not re-run, so compute rate-dependent coefficients in setup().
+		virtual void configure(float sampleRate, int maxBlock = KLANG_BLOCK_SIZE) {
+			context = Context(sampleRate, maxBlock);
+			onSetup();
+			onRestart();
+		}
+
+		/// Tail length in seconds (how long output continues after the input stops; e.g. for the host)
+		virtual float tail() const { return 0.f; }
+
+		// events use the plugin's context
+		virtual void onControl(int index, float value) override { Context::Scope scope(context); control(index, value); };
+		virtual void onPreset(int index) override { Context::Scope scope(context); preset(index); };
+		virtual void onMIDI(int status, int byte1, int byte2) override { Context::Scope scope(context); midi(status, byte1, byte2); }
+		virtual void onSetup() override { Context::Scope scope(context); setup(); }
+		virtual void onRestart() override { Context::Scope scope(context); restart(); }
+
+	protected:
+		bool splitting = false;
 	};
 
 	/// Effect mini-plugin (mono)
 	struct Effect : public Plugin, public Modifier {
 		virtual ~Effect() {}
 
+		Silence silence; ///< sleep once input and output stay silent (opt-in; set silence.threshold)
+
+		virtual float tail() const override { return silence.tail(); }
+
 		virtual void prepare() {};
 		virtual void process() { out = in; }
-		virtual void process(buffer buffer) {
-			prepare();
-			while (!buffer.finished()) {
-				input(buffer);
+		virtual void process(const signal* input, signal* output, int length) override {
+			for (int s = 0; s < length; s++) {
+				this->input(input[s]);
 				this->process();
-				buffer++ = out;
+				output[s] = out;
 				debug.buffer++;
 			}
 		}
+		virtual void process(buffer buffer) {
+			Context::Scope scope(context);
+			(void)debug.buffer; // per-thread (allocates on first use)
+			Realtime::Scope realtime;
+			receive();
+			signal* samples = buffer.pointer();
+			const int length = buffer.remaining();
+
+			// asleep: skip processing until the input returns (events still apply)
+			const bool input = silence.enabled() && silence.loud((const float*)samples, length);
+			if (silence.silent() && !input) {
+				split(length, [](int, int) {});
+				for (int s = 0; s < length; s++)
+					samples[s] = 0.f;
+				return;
+			}
+
+			split(length, [&](int offset, int length) {
+				this->prepare();
+				this->process(samples + offset, samples + offset, length);
+			});
+			if (silence.enabled())
+				silence.update(input, silence.loud((const float*)samples, length), length);
+		}
+	};
+
+	/// Voice mix settings (applied by the synth's mix bus; changes ramp over a block)
+	struct Mix {
+		float gain = 1.f;				///< linear gain
+		float pan = 0.f;				///< -1 (left) .. +1 (right), constant-power (stereo synths)
+		float send[2] = { 0.f, 0.f };	///< levels to the send buses (see Bus::send)
+
+		/// @cond
+		float applied[4] = { 0.f };		// levels last applied (left, right, sends)
+		bool started = false;			// levels applied since the note started
+		bool fading = false;			// ramping to silence over this block, then stopped (see Notes::limit)
+		/// @endcond
+	};
+
+	/// Voice mix bus (voices render to scratch, then accumulate into the output with their gain, pan and sends)
+	struct Bus {
+		static constexpr int sends = 2;
+
+		int length = 0;	///< maximum block length
+		int block = 0;	///< length of the block being mixed
+
+		Bus() { allocate(KLANG_BLOCK_SIZE); }
+		~Bus() { Pool::release(samples, capacity); }
+		Bus(const Bus&) = delete;
+		Bus& operator=(const Bus&) = delete;
+
+		// size for blocks of up to length samples (allocates; call outside the render)
+		void allocate(int length) {
+			Pool::release(samples, capacity);
+			Bus::length = length;
+			stride = (length + 15) & ~15;
+			capacity = (2 + sends) * stride;
+			samples = Pool::allocate(capacity);
+			memset(samples, 0, sizeof(float) * capacity);
+		}
+
+		float* left() { return samples; }
+		float* right() { return samples + stride; }
+		float* send(int index) { return samples + (2 + index) * stride; }
+
+		// start a block (silencing the sends)
+		void clear(int length) {
+			block = length;
+			for (int i = 0; i < sends; i++)
+				memset(send(i), 0, sizeof(float) * length);
+		}
+
+		// add a mono voice to the output
+		void mix(Mix& mix, const float* in, float* out, int length) {
+			const float gain = mix.fading ? 0.f : mix.gain;
+			float target[2 + sends] = { gain, gain };
+			for (int i = 0; i < sends; i++)
+				target[2 + i] = gain * mix.send[i];
+
+			float from[2 + sends];
+			ramp(mix, target, from);
+			simd::mix(out, in, from[0], target[0], length);
+			for (int i = 0; i < sends; i++)
+				if (from[2 + i] != 0 || target[2 + i] != 0)
+					simd::mix(send(i), in, from[2 + i], target[2 + i], length);
+		}
+
+		// add a stereo voice to the outputs (constant-power pan, unity at centre)
+		void mix(Mix& mix, const float* left, const float* right, float* outL, float* outR, int length) {
+			const float gain = mix.fading ? 0.f : mix.gain;
+			float target[2 + sends] = { gain, gain };
+			if (mix.pan != 0) {
+				const float angle = (std::clamp(mix.pan, -1.f, 1.f) + 1.f) * (pi / 4.f);
+				target[0] = gain * 1.41421356f * cosf(angle);
+				target[1] = gain * 1.41421356f * sinf(angle);
+			}
+			for (int i = 0; i < sends; i++)
+				target[2 + i] = gain * mix.send[i] * 0.5f;
+
+			float from[2 + sends];
+			ramp(mix, target, from);
+			simd::mix(outL, left, from[0], target[0], length);
+			simd::mix(outR, right, from[1], target[1], length);
+			for (int i = 0; i < sends; i++) {
+				if (from[2 + i] != 0 || target[2 + i] != 0) {
+					simd::mix(send(i), left, from[2 + i], target[2 + i], length);
+					simd::mix(send(i), right, from[2 + i], target[2 + i], length);
+				}
+			}
+		}
+
+	protected:
+		float* samples = nullptr;
+		unsigned int capacity = 0;
+		int stride = 0;
+
+		// levels to ramp from (the last applied, or the target for a new note)
+		static void ramp(Mix& mix, const float* target, float* from) {
+			for (int i = 0; i < 2 + sends; i++) {
+				from[i] = mix.started ? mix.applied[i] : target[i];
+				mix.applied[i] = target[i];
+			}
+			mix.started = true;
+		}
 	};
 
 	/// Base class for synthesiser notes
@@ -3311,8 +5763,17 @@ namespace klang {
 
 		class Controls {
 			klang::Controls* controls = nullptr;
+			const Snapshot* snapshot = nullptr;
 		public:
 			Controls& operator=(klang::Controls& controls) { Controls::controls = &controls; return *this; }
+			void attach(klang::Controls& controls, const Snapshot& snapshot) { Controls::controls = &controls; Controls::snapshot = &snapshot; }
+
+			/// Control value for this block (from the synth's snapshot; cheaper than operator[] in voice loops)
+			float value(int index) const { return snapshot->value[index]; }
+			/// Control value ramped linearly across the block (sample s of length)
+			float ramp(int index, int s, int length) const { return snapshot->from[index] + (snapshot->value[index] - snapshot->from[index]) * s / length; }
+			const Snapshot& values() const { return *snapshot; }
+
 			//signal& operator[](int index) { return controls->operator[](index).operator signal & (); }
 			//const signal& operator[](int index) const { return controls->operator[](index).operator const signal & (); }
 			Control& operator[](int index) { return controls->operator[](index); }
@@ -3324,27 +5785,42 @@ namespace klang {
 		virtual event on(Pitch p, Velocity v) {}
 		virtual event off(Velocity v = 0) { stage = Off; }
 
-		SYNTH* getSynth() { return synth; }
+		//SYNTH* getSynth() { return synth; }
+		auto getSynth() { return static_cast<std::remove_pointer_t<decltype(synth)>*>(synth); }
 	public:
 		Pitch pitch;
 		Velocity velocity;
 		Controls controls;
+		Mix mix; ///< gain, pan and sends (see Bus)
+		Silence silence; ///< retire the note once released and silent (opt-in; see Notes::retire)
+		Random prng{ 0 }; ///< voice's own stream for random() (seeded per voice by Notes)
 
 		NoteBase() : synth(nullptr) {}
 		virtual ~NoteBase() {}
 
 		void attach(SYNTH* synth) {
 			NoteBase::synth = synth;
-			controls = synth->controls;
+			controls.attach(synth->controls, synth->snapshot);
 			init();
 		}
 
 		virtual void init() {}
 
+		/// Controls changed since the last block (once per block, before rendering; default passes each to onControl)
+		virtual void changed(const Snapshot& controls) {
+			for (unsigned int c = 0; c < controls.count; c++)
+				if (controls.changed(c))
+					onControl(c, controls[c]);
+		}
+
 		virtual void start(Pitch p, Velocity v) {
 			stage = Onset;
 			pitch = p;
 			velocity = v;
+			mix.started = false;
+			mix.fading = false;
+			silence.reset();
+			Random::Scope stream(prng);
 			on(pitch, velocity);
 			stage = Sustain;
 		}
@@ -3355,6 +5831,7 @@ namespace klang {
 
 			if (stage != Release) {
 				stage = Release;
+				Random::Scope stream(prng);
 				off(v);
 			}
 
@@ -3368,6 +5845,14 @@ namespace klang {
 
 		bool finished() const { return stage == Off; }
 
+		// released and below the silence threshold for its hold time (given the note's latest output)
+		bool decayed(const float* left, const float* right, int length) {
+			if (stage != Release || !silence.enabled())
+				return false;
+			silence.update(false, silence.loud(left, length) || (right && silence.loud(right, length)), length);
+			return silence.silent();
+		}
+
 		enum Stage { Onset, Sustain, Release, Off } stage = Off;
 
 		virtual void controlChange(int controller, int value) { midi(0xB0, controller, value); };
@@ -3379,21 +5864,33 @@ namespace klang {
 	struct Note : public NoteBase<Synth>, public Generator {
 		virtual void prepare() {}
 		virtual void process() override = 0;
-		virtual bool process(buffer buffer) {
-			prepare();
-			while (!buffer.finished()) {
+		virtual void process(signal* output, int length) override {
+			for (int s = 0; s < length; s++) {
 				this->process();
-				buffer++ = out;
+				output[s] = out;
 				debug.buffer++;
 			}
+		}
+		virtual bool process(buffer buffer) {
+			this->prepare();
+			this->process(buffer.pointer(), buffer.remaining());
 			return !finished();
 		}
 		virtual bool process(buffer* buffer) {
-			return process(buffer[0]);
+			return this->process(buffer[0]);
 		}
 	};
 
-	/// Synthesiser note array
+	/// @cond
+	// batched voices (see Batch)
+	struct Batched {
+		virtual ~Batched() {}
+		virtual void reserve(int length) = 0;
+		virtual void render(int length) = 0;
+	};
+	/// @endcond
+
+	/// Synthesiser note array (with voice allocator)
 	template<class SYNTH, class NOTE = Note>
 	struct Notes : Array<NOTE*, 128> {
 		SYNTH* synth;
@@ -3402,60 +5899,313 @@ namespace klang {
 		using Array::count;
 
 		Notes(SYNTH* synth) : synth(synth) {
-			for (int n = 0; n < 128; n++)
+			for (int n = 0; n < 128; n++) {
 				items[n] = nullptr;
+				voice[n] = { -1, -1, -1, -1, Free, -1, 0, 0.f };
+				first[n] = -1;
+			}
 		}
 		virtual ~Notes();
 
+		// add count voices of TYPE, stored contiguously (one cache-line aligned slot per voice)
 		template<class TYPE>
 		void add(int count) {
-			for (int n = 0; n < count; n++) {
-				TYPE* note = new TYPE();
-				note->attach(synth);
-				Array::add(note);
+			count = std::min(count, 128 - (int)Array::count);
+			if (count <= 0)
+				return;
+			const unsigned int streams = Random::number(0); // voices number their own random streams (below)
+			if constexpr (std::is_base_of_v<Batched, TYPE>) {
+				// one note per lane, rendered by a shared batch
+				typedef typename TYPE::template Voice<NOTE> VOICE;
+				size_t stride;
+				char* slots = allocate<VOICE>(count, stride);
+				for (int n = 0; n < count; n += TYPE::lanes) {
+					Random::number(stream(Array::count));
+					TYPE* batch = new TYPE();
+					batch->reserve(reserved);
+					spans[batches.count] = { (int)Array::count, std::min((int)TYPE::lanes, count - n) };
+					batches.add(batch);
+					for (int lane = 0; lane < TYPE::lanes && n + lane < count; lane++) {
+						Random::number(stream(Array::count) + 0x8000);
+						add(new (slots + (n + lane) * stride) VOICE(batch, lane), kind<TYPE>());
+					}
+				}
+			} else {
+				size_t stride;
+				char* slots = allocate<TYPE>(count, stride);
+				for (int n = 0; n < count; n++) {
+					Random::number(stream(Array::count));
+					add(new (slots + n * stride) TYPE(), kind<TYPE>());
+				}
 			}
+			Random::number(streams);
+		}
+
+		// first random stream of voice n (repeatable whatever else is constructed)
+		static unsigned int stream(int n) { return (unsigned int)(n + 1) << 16; }
+
+		klang::Array<Batched*, 128> batches;	// batched voices (rendered ahead of the notes)
+		struct Span { int first, count; } spans[128];	// voices of each batch (one per lane)
+		int reserved = KLANG_BLOCK_SIZE;	// maximum batch render length
+
+		// size batch output for blocks of up to length samples (allocates; call outside the render)
+		void reserve(int length) {
+			reserved = length;
+			for (unsigned int b = 0; b < batches.count; b++)
+				batches.items[b]->reserve(length);
 		}
 
-		// returns index of a 'free' note (stealing oldest, if required)
-		unsigned int noteOns = 0;				// number of NoteOn events processed
-		unsigned int noteStart[128] = { 0 };	// track age of notes (for note stealing)
+		// retire released notes once their output stays below threshold for hold seconds
+		void retire(float threshold, float hold = 0.1f) {
+			for (unsigned int n = 0; n < count; n++) {
+				items[n]->silence.threshold = threshold;
+				items[n]->silence.hold = hold;
+			}
+		}
 
-		int assign() {
-			// favour unused voices
-			for (unsigned int i = 0; i < count; i++) {
-				if (items[i]->stage == NOTE::Off) {
-					noteStart[i] = noteOns++;
-					return i;
+		// render batched voices (all lanes at once) for the next length samples
+		void render(int length) {
+			for (unsigned int b = 0; b < batches.count; b++) {
+				const auto start = clock();
+				batches.items[b]->render(length);
+				if (budget > 0.f) {
+					// split the batch's time across its sounding voices (added to their own cost; see measured)
+					const Span& span = spans[b];
+					int sounding = 0;
+					for (int n = span.first; n < span.first + span.count; n++)
+						sounding += items[n]->stage != NOTE::Off;
+					const float share = sounding ? elapsed(start) / sounding : 0.f;
+					for (int n = span.first; n < span.first + span.count; n++)
+						if (items[n]->stage != NOTE::Off)
+							voice[n].batched += share;
 				}
 			}
+		}
+
+		/// CPU budget for rendering voices, as a fraction of the block period (0 = unlimited)
+		/// Voice times are summed, so with worker threads this bounds the total CPU time across threads, not the wall time
+		/// (e.g. scale by the thread count to budget wall time).
+		float budget = 0.f;
+
+		typedef std::chrono::steady_clock Clock;
 
-			// no free notes => steal oldest released note?
-			int oldest = -1;
-			unsigned int oldest_start = 0;
-			for (unsigned int i = 0; i < count; i++) {
-				if (items[i]->stage == NOTE::Release) {
-					if (oldest == -1 || noteStart[i] < oldest_start) {
-						oldest = i;
-						oldest_start = noteStart[i];
+		// start timing a voice (when budgeted)
+		Clock::time_point clock() const { return budget > 0.f ? Clock::now() : Clock::time_point(); }
+
+		// seconds since start (when budgeted)
+		float elapsed(Clock::time_point start) const {
+			return budget > 0.f ? std::chrono::duration<float>(Clock::now() - start).count() : 0.f;
+		}
+
+		// note n took seconds to render length samples (updates the average cost of its type)
+		void measured(int n, float seconds, int length) {
+			if (budget <= 0.f || length <= 0)
+				return;
+			float& cost = costs.items[voice[n].cost].seconds;
+			const float sample = (seconds + voice[n].batched) / length;
+			voice[n].batched = 0.f;
+			cost = cost == 0.f ? sample : cost + (sample - cost) * 0.0625f;
+		}
+
+		// fade out released notes (quietest or oldest first) until the projected cost of the next length samples fits the budget
+		// (faded notes ramp to silence over the next block, then stop)
+		void limit(int length) {
+			if (budget <= 0.f)
+				return;
+			const float allowed = budget * length * fs.inv;
+			float projected = 0.f;
+			for (List list : { Playing, Released })
+				for (int n = head[list]; n != -1; n = voice[n].next)
+					projected += costs.items[voice[n].cost].seconds * length;
+			while (projected > allowed) {
+				int n = -1;
+				float min = 0;
+				for (int r = head[Released]; r != -1; r = voice[r].next) {
+					if (items[r]->mix.fading)
+						continue;
+					const float x = policy == Quietest ? level(items[r]) : 0.f;
+					if (n == -1 || x < min) {
+						n = r;
+						min = x;
 					}
 				}
+				if (n == -1)
+					break;
+				projected -= costs.items[voice[n].cost].seconds * length;
+				items[n]->mix.fading = true;
+			}
+		}
+
+		/// Voice stealing policy (when no voices are free)
+		enum Policy {
+			Oldest,		// oldest released voice, else oldest playing voice
+			Quietest,	// quietest sounding voice
+			Retrigger,	// voice already sounding the same pitch, else oldest
+		} policy = Oldest;
+
+		// returns index of a 'free' note (stealing, if required)
+		int assign(int pitch = -1) {
+			int n = -1;
+			if (policy == Retrigger && pitch >= 0 && pitch < 128 && first[pitch] != -1)
+				n = first[pitch];
+			else if (head[Free] != -1)
+				n = head[Free];
+			else if (policy == Quietest)
+				n = quietest();
+			else
+				n = head[Released] != -1 ? head[Released] : head[Playing];
+			return n;
+		}
+
+		// note n started (at pitch)
+		void started(int n, int pitch) {
+			unlink(n);
+			append(Playing, n);
+			if (pitch >= 0 && pitch < 128) {
+				voice[n].pitch = pitch;
+				voice[n].down = -1;
+				voice[n].up = first[pitch];
+				if (first[pitch] != -1)
+					voice[first[pitch]].down = n;
+				first[pitch] = n;
+			}
+		}
+
+		// release sustained notes at pitch
+		void release(int pitch, float velocity) {
+			if (pitch < 0 || pitch >= 128)
+				return;
+			for (int n = first[pitch]; n != -1;) {
+				const int next = voice[n].up;
+				if (items[n]->stage == NOTE::Sustain)
+					items[n]->release(velocity);
+				update(n);
+				n = next;
+			}
+		}
+
+		// re-file note n after its stage may have changed (e.g. after processing)
+		void update(int n) {
+			const List list = items[n]->stage == NOTE::Off ? Free : items[n]->stage == NOTE::Release ? Released : Playing;
+			if (list != voice[n].list) {
+				unlink(n);
+				append(list, n);
+			}
+		}
+
+		// call function(note) for each sounding note
+		template<typename FUNCTION>
+		void sounding(FUNCTION function) {
+			for (List list : { Playing, Released }) {
+				for (int n = head[list]; n != -1;) {
+					const int next = voice[n].next;
+					if (items[n]->stage != NOTE::Off)
+						function(items[n]);
+					n = next;
+				}
 			}
-			if (oldest != -1) {
-				noteStart[oldest] = noteOns++;
-				return oldest;
+		}
+
+	protected:
+		enum List : signed char { Free, Playing, Released };
+
+		void add(NOTE* note, int cost) {
+			note->prng.seed(stream(Array::count) + 0xC000);
+			note->attach(synth);
+			if (Array::count < 128) {
+				append(Free, Array::count);
+				voice[Array::count].cost = cost;
 			}
+			Array::add(note);
+		}
+
+		// voice storage (one block per add; voices are constructed in place)
+		struct Arena { float* memory; unsigned int capacity; };
+		klang::Array<Arena, 128> arenas;
+
+		// storage for count voices of TYPE, each padded to whole cache lines (stride = bytes per voice)
+		template<class TYPE>
+		char* allocate(int count, size_t& stride) {
+			static_assert(alignof(TYPE) <= Pool::alignment, "voice alignment exceeds the pool alignment");
+			stride = (sizeof(TYPE) + Pool::alignment - 1) & ~(Pool::alignment - 1);
+			const unsigned int capacity = (unsigned int)((stride * count + sizeof(float) - 1) / sizeof(float));
+			float* memory = Pool::allocate(capacity);
+			arenas.add({ memory, capacity });
+			return (char*)memory;
+		}
+
+		// average render cost per note type (seconds per sample)
+		struct Cost { const void* type; float seconds; };
+		klang::Array<Cost, 16> costs;
+
+		// cost index for a note type
+		template<class TYPE>
+		int kind() {
+			static const char type = 0;
+			for (unsigned int c = 0; c < costs.count; c++)
+				if (costs.items[c].type == &type)
+					return c;
+			if (costs.count == 16)
+				return 15; // share the last entry
+			costs.add({ &type, 0.f });
+			return costs.count - 1;
+		}
+
+		// intrusive links (per voice): age-ordered list, pitch chain of sounding notes, and cost type
+		struct Voice { int prev, next, up, down; List list; int pitch; int cost; float batched; } voice[128];
+		int head[3] = { -1, -1, -1 }, tail[3] = { -1, -1, -1 };
+		int first[128]; // first sounding voice per pitch
+
+		void append(List list, int n) {
+			voice[n].list = list;
+			voice[n].prev = tail[list];
+			voice[n].next = -1;
+			if (tail[list] != -1)
+				voice[tail[list]].next = n;
+			else
+				head[list] = n;
+			tail[list] = n;
+			if (list == Free)
+				unmap(n);
+		}
+
+		void unlink(int n) {
+			Voice& v = voice[n];
+			if (v.prev != -1) voice[v.prev].next = v.next; else head[v.list] = v.next;
+			if (v.next != -1) voice[v.next].prev = v.prev; else tail[v.list] = v.prev;
+			v.prev = v.next = -1;
+			unmap(n);
+		}
 
-			// no available released notes => steal oldest playing note
-			oldest = -1;
-			oldest_start = 0;
-			for (unsigned int i = 0; i < count; i++) {
-				if (oldest == -1 || noteStart[i] < oldest_start) {
-					oldest = i;
-					oldest_start = noteStart[i];
+		void unmap(int n) {
+			Voice& v = voice[n];
+			if (v.pitch == -1)
+				return;
+			if (v.down != -1) voice[v.down].up = v.up; else first[v.pitch] = v.up;
+			if (v.up != -1) voice[v.up].down = v.down;
+			v.pitch = v.up = v.down = -1;
+		}
+
+		static float level(const NOTE* note) {
+			if constexpr (std::is_convertible_v<decltype(note->out), float>)
+				return std::abs(float(note->out));
+			else
+				return std::abs(float(note->out.mono()));
+		}
+
+		int quietest(std::initializer_list<List> lists = { Released, Playing }) const {
+			int quietest = -1;
+			float min = 0;
+			for (List list : lists) {
+				for (int n = head[list]; n != -1; n = voice[n].next) {
+					const float x = level(items[n]);
+					if (quietest == -1 || x < min) {
+						quietest = n;
+						min = x;
+					}
 				}
 			}
-			noteStart[oldest] = noteOns++;
-			return oldest;
+			return quietest;
 		}
 	};
 
@@ -3464,9 +6214,20 @@ namespace klang {
 		typedef Note Note;
 
 		Notes<Synth, Note> notes;
+		Bus bus; ///< voice mix bus (sends readable during post processing)
+		Snapshot snapshot; ///< control values for the block being rendered (read by notes; changes reach notes once per block)
 
 		Synth() : notes(this) {}
-		virtual ~Synth() {}
+		virtual ~Synth() { Pool::release(scratch.samples, scratch.capacity); }
+
+		/// Send bus output for the block being post-processed (see Mix::send)
+		klang::buffer send(int index) { return { bus.send(index), bus.block }; }
+
+		/// Render voices on count threads (notes must only add to their buffer; output matches serial rendering)
+		void parallel(int count) {
+			workers.start(count);
+			allocate();
+		}
 
 		//virtual void presetLoaded(int preset) { }
 		//virtual void optionChanged(int param, int item) { }
@@ -3482,42 +6243,67 @@ namespace klang {
 			return -1; // not found
 		}
 
-		// pass to synth and notes
-		virtual event onControl(int index, float value) override {
-			control(index, value);
-			for (unsigned int n = 0; n < notes.count; n++)
-				if (notes[n]->stage != Note::Off)
-					notes[n]->onControl(index, value);
-		};
-
 		// pass to synth and notes
 		virtual event onMIDI(int status, int byte1, int byte2) override {
-			onMIDI(status, byte1, byte2);
-			for (unsigned int n = 0; n < notes.count; n++)
-				if (notes[n]->stage != Note::Off)
-					notes[n]->onMIDI(status, byte1, byte2);
+			Context::Scope scope(context);
+			midi(status, byte1, byte2);
+			notes.sounding([&](Note* note) { note->onMIDI(status, byte1, byte2); });
 		}
 
 		// pass to synth and notes
 		virtual event onPreset(int index) override {
+			Context::Scope scope(context);
 			preset(index);
-			for (unsigned int n = 0; n < notes.count; n++)
-				if (notes[n]->stage != Note::Off)
-					notes[n]->onPreset(index);
+			notes.sounding([&](Note* note) { note->onPreset(index); });
 		};
 
+		// pass to synth and notes
+		virtual void onSetup() override {
+			Context::Scope scope(context);
+			reserve(context.maxBlock);
+			setup();
+			snapshot.publish(controls);
+			for (unsigned int n = 0; n < notes.count; n++)
+				notes[n]->onSetup();
+		}
+
+		// pass to synth and notes (silencing any playing)
+		virtual void onRestart() override {
+			Context::Scope scope(context);
+			restart();
+			for (unsigned int n = 0; n < notes.count; n++) {
+				notes[n]->stop();
+				notes[n]->onRestart();
+				notes.update(n);
+			}
+		}
+
 		// assign and start note
 		virtual event noteOn(int pitch, float velocity) {
-			const int n = notes.assign();
-			if (n != -1)
+			Context::Scope scope(context);
+			const int n = notes.assign(pitch);
+			if (n != -1) {
 				notes[n]->start((float)pitch, velocity);
+				notes.started(n, pitch);
+			}
 		}
 
 		// trigger note off (release)
 		virtual event noteOff(int pitch, float velocity) {
-			for (unsigned int n = 0; n < notes.count; n++)
-				if (notes[n]->pitch == pitch && notes[n]->stage == Note::Sustain)
-					notes[n]->release(velocity);
+			Context::Scope scope(context);
+			notes.release(pitch, velocity);
+		}
+
+		// note on / off messages start and release notes
+		virtual void dispatch(const Event& event) override {
+			if (event.type == Event::MIDI) {
+				const int type = event.midi.status & 0xF0;
+				if (type == 0x90 && event.midi.byte2 > 0)
+					return noteOn(event.midi.byte1, event.midi.byte2 / 127.f);
+				if (type == 0x80 || type == 0x90)
+					return noteOff(event.midi.byte1, event.midi.byte2 / 127.f);
+			}
+			Effect::dispatch(event);
 		}
 
 		// post processing (see Effect::process)
@@ -3525,41 +6311,146 @@ namespace klang {
 		virtual void process(buffer buffer) override { Effect::process(buffer); }
 
 		virtual void process(float* buffer, int length, float* parameters = nullptr) {
-			klang::buffer mono(buffer, length);
+			if (length > bus.length)
+				reserve(length); // host block exceeds the configured maximum (allocates, once; see configure)
+			Context::Scope scope(context);
+			(void)debug.buffer; // per-thread (allocates on first use)
+			Realtime::Scope realtime;
 
-			// sync parameters
+			// sync parameters (changes only)
 			if (parameters) {
 				for (unsigned int c = 0; c < controls.size(); c++)
-					controls[c].set(parameters[c]);
+					if (parameters[c] != controls[c].value)
+						controls.exchange.write(c, parameters[c]);
 			}
+			receive();
 
-			// generate note audio
-			for (unsigned int n = 0; n < notes.count; n++) {
-				Note* note = notes[n];
-				if (note->stage != Note::Off) {
-					if (!note->process(mono))
-						note->stop();
-				}
-			}
+			// render between queued events (sample-accurate; post processing sees each span whole)
+			split(length, [&](int offset, int length) {
+				generate(buffer + offset, length);
 
-			// apply post processing
-			this->process(mono);
+				// apply post processing
+				klang::buffer block(buffer + offset, length);
+				this->process(block);
+			});
 
 			// sync update (changed by process())
 			if (parameters) {
 				for (unsigned int c = 0; c < controls.size(); c++)
-					parameters[c] = controls[c].value;
+					if (parameters[c] != controls[c].value)
+						parameters[c] = controls[c].value;
+			}
+		}
+
+	protected:
+		Workers workers;
+
+		// size voice buffers for blocks of up to length samples (allocates; call outside the render)
+		void reserve(int length) {
+			context.maxBlock = length;
+			notes.reserve(length);
+			bus.allocate(length);
+			allocate();
+		}
+
+		// per-voice scratch (64-byte aligned)
+		struct {
+			float* samples = nullptr;
+			unsigned int capacity = 0;
+			int length = 0;      ///< samples per voice
+			int stride = 0;      ///< floats per voice (rounded up to a cache line)
+		} scratch;
+
+		// generate note audio (each voice to scratch, then mixed into the output in voice order; batched voices render first)
+		void generate(float* output, int length) {
+			assert(length <= notes.reserved);
+			notes.limit(length);
+			if (snapshot.publish(controls))
+				notes.sounding([&](Note* note) { note->changed(snapshot); });
+			notes.render(length);
+			bus.clear(length);
+			memset(output, 0, sizeof(float) * length);
+			if (workers.size() && scratch.samples) {
+				assert(length <= scratch.length);
+				render(output, length);
+			} else {
+				for (unsigned int n = 0; n < notes.count; n++) {
+					Note* note = notes[n];
+					if (note->stage != Note::Off) {
+						klang::buffer voice(bus.left(), length, 0.f);
+						Random::Scope stream(note->prng);
+						const auto start = notes.clock();
+						const bool finished = !note->process(voice);
+						notes.measured(n, notes.elapsed(start), length);
+						if (finished || note->mix.fading || note->decayed(bus.left(), nullptr, length))
+							note->stop();
+						bus.mix(note->mix, bus.left(), output, length);
+						notes.update(n);
+					}
+				}
+			}
+		}
+
+		void allocate() {
+			Pool::release(scratch.samples, scratch.capacity);
+			scratch = {};
+			if (!workers.size() || !notes.count)
+				return;
+			scratch.length = context.maxBlock;
+			scratch.stride = (scratch.length + 15) & ~15;
+			scratch.capacity = scratch.stride * notes.count;
+			scratch.samples = Pool::allocate(scratch.capacity);
+		}
+
+		// render active voices into their own scratch on the workers, then mix in voice order
+		void render(float* output, int length) {
+			int active[128];
+			bool finished[128];
+			float seconds[128];
+			int voices = 0;
+			for (unsigned int n = 0; n < notes.count; n++)
+				if (notes[n]->stage != Note::Off)
+					active[voices++] = n;
+
+			auto voice = [&](int v) {
+				const int n = active[v];
+				klang::buffer out(scratch.samples + n * scratch.stride, length, 0.f);
+				const SampleRate previous = klang::fs; // thread's sample rate
+				klang::fs = context.fs;
+				(void)debug.buffer; // per-thread (allocates on first use)
+				Realtime::Scope realtime;
+				Random::Scope stream(notes[n]->prng);
+				const auto start = notes.clock();
+				finished[v] = !notes[n]->process(out);
+				seconds[v] = notes.elapsed(start);
+				klang::fs = previous;
+			};
+			workers.run(voices, voice);
+
+			for (int v = 0; v < voices; v++) {
+				const int n = active[v];
+				const float* samples = scratch.samples + n * scratch.stride;
+				bus.mix(notes[n]->mix, samples, output, length);
+				notes.measured(n, seconds[v], length);
+				if (finished[v] || notes[n]->mix.fading || notes[n]->decayed(samples, nullptr, length))
+					notes[n]->stop();
+				notes.update(n);
 			}
 		}
 	};
 
 	template<class SYNTH, class NOTE>
 	inline Notes<SYNTH, NOTE>::~Notes() {
+		// voices in order, then their storage
 		for (unsigned int n = 0; n < count; n++) {
 			NOTE* tmp = items[n];
 			items[n] = nullptr;
-			delete tmp;
+			tmp->~NOTE();
 		}
+		for (unsigned int a = 0; a < arenas.count; a++)
+			Pool::release(arenas.items[a].memory, arenas.items[a].capacity);
+		for (unsigned int b = 0; b < batches.count; b++)
+			delete batches.items[b];
 	}
 
 	namespace Mono { using namespace klang; }
@@ -3660,6 +6551,18 @@ namespace klang {
 		//	return modifier;
 		//}
 
+		/// Stereo sample view (e.g. separate or interleaved channels; trivially copyable)
+		struct view {
+			klang::view left, right;
+
+			// view of interleaved (LRLR...) samples
+			static view interleaved(mono::signal* samples, int length) {
+				return { { samples, length, 2 }, { samples + 1, length, 2 } };
+			}
+		};
+
+		IS_SIMPLE_TYPE(view)
+
 		/// Stereo audio buffer
 		// interleaved access to non-interleaved stereo buffers
 		struct buffer {
@@ -3724,6 +6627,8 @@ namespace klang {
 				left.rewind();
 				right.rewind();
 			}
+
+			operator Stereo::view() { return { left, right }; }
 		};
 
 		/// Stereo audio object adapter
@@ -3790,17 +6695,66 @@ namespace klang {
 		struct Effect : public Plugin, public Modifier {
 			virtual ~Effect() {}
 
+			Silence silence; ///< sleep once input and output stay silent (opt-in; set silence.threshold)
+
+			virtual float tail() const override { return silence.tail(); }
+
 			virtual void prepare() {};
 			virtual void process() { out = in; };
-			virtual void process(Stereo::buffer buffer) {
-				prepare();
-				while (!buffer.finished()) {
-					input(buffer);
-					process();
-					buffer++ = out;
+			virtual void process(const signal* input, signal* output, int length) override {
+				for (int s = 0; s < length; s++) {
+					this->input(input[s]);
+					this->process();
+					output[s] = out;
 					debug.buffer++;
 				}
 			}
+			virtual void process(Stereo::buffer buffer) {
+				this->process(Stereo::view(buffer));
+			}
+			virtual void process(Stereo::view buffer) {
+				Context::Scope scope(context);
+				(void)debug.buffer; // per-thread (allocates on first use)
+				Realtime::Scope realtime;
+				receive();
+
+				// asleep: skip processing until the input returns (events still apply)
+				const bool input = silence.enabled() && loud(buffer);
+				if (silence.silent() && !input) {
+					split(buffer.left.length, [](int, int) {});
+					for (int s = 0; s < buffer.left.length; s++)
+						buffer.left[s] = buffer.right[s] = 0.f;
+					return;
+				}
+
+				split(buffer.left.length, [&](int offset, int length) {
+					this->prepare();
+					signal block[KLANG_BLOCK_SIZE];
+					klang::view left = buffer.left, right = buffer.right;
+					left.advance(offset); right.advance(offset);
+					left.length = right.length = length;
+					while (left.length > 0) {
+						const int length = left.length < KLANG_BLOCK_SIZE ? left.length : KLANG_BLOCK_SIZE;
+						for (int s = 0; s < length; s++)
+							block[s] = { left[s], right[s] };
+						this->process(block, block, length);
+						for (int s = 0; s < length; s++) {
+							left[s] = block[s].l;
+							right[s] = block[s].r;
+						}
+						left.advance(length); right.advance(length);
+					}
+				});
+				if (silence.enabled())
+					silence.update(input, loud(buffer), buffer.left.length);
+			}
+
+		protected:
+			// either channel peaks above the silence threshold
+			bool loud(const Stereo::view& buffer) const {
+				return silence.loud((const float*)buffer.left.samples, buffer.left.length, buffer.left.stride)
+					|| silence.loud((const float*)buffer.right.samples, buffer.right.length, buffer.right.stride);
+			}
 		};
 
 		struct Synth;
@@ -3811,17 +6765,28 @@ namespace klang {
 
 			virtual void prepare() {}
 			virtual void process() override = 0;
+			using Generator::process;
 			virtual bool process(Stereo::buffer buffer) {
-				prepare();
-				while (!buffer.finished()) {
-					process();
-					buffer++ += out;
+				return this->process(Stereo::view(buffer));
+			}
+			virtual bool process(Stereo::view buffer) {
+				this->prepare();
+				signal block[KLANG_BLOCK_SIZE];
+				klang::view left = buffer.left, right = buffer.right;
+				while (left.length > 0) {
+					const int length = left.length < KLANG_BLOCK_SIZE ? left.length : KLANG_BLOCK_SIZE;
+					this->process(block, length);
+					for (int s = 0; s < length; s++) {
+						left[s] += block[s].l;
+						right[s] += block[s].r;
+					}
+					left.advance(length); right.advance(length);
 				}
 				return !finished();
 			}
 			virtual bool process(mono::buffer* buffers) {
 				buffer buffer = { buffers[0], buffers[1] };
-				return process(buffer);
+				return this->process(buffer);
 			}
 		};
 
@@ -3831,13 +6796,19 @@ namespace klang {
 
 				virtual void prepare() override {}
 				virtual void process() override = 0;
-				virtual bool process(Stereo::buffer buffer) override {
-					prepare();
-					while (!buffer.finished()) {
-						process();
-						buffer.left += out;
-						buffer.right += out;
-						buffer++;
+				virtual bool process(Stereo::view buffer) override {
+					this->prepare();
+					klang::Mono::Generator& generator = *this; // mono block path
+					mono::signal block[KLANG_BLOCK_SIZE];
+					klang::view left = buffer.left, right = buffer.right;
+					while (left.length > 0) {
+						const int length = left.length < KLANG_BLOCK_SIZE ? left.length : KLANG_BLOCK_SIZE;
+						generator.process(block, length);
+						for (int s = 0; s < length; s++) {
+							left[s] += block[s];
+							right[s] += block[s];
+						}
+						left.advance(length); right.advance(length);
 					}
 					return !finished();
 				}
@@ -3855,8 +6826,20 @@ namespace klang {
 				using klang::Notes<Synth, Note>::Notes;
 			} notes;
 
+			Bus bus; ///< voice mix bus (sends readable during post processing)
+			Snapshot snapshot; ///< control values for the block being rendered (read by notes; changes reach notes once per block)
+
 			Synth() : notes(this) {}
-			virtual ~Synth() {}
+			virtual ~Synth() { Pool::release(scratch.samples, scratch.capacity); }
+
+			/// Send bus output for the block being post-processed (see Mix::send)
+			klang::buffer send(int index) { return { bus.send(index), bus.block }; }
+
+			/// Render voices on count threads (notes must only add to their buffer; output matches serial rendering)
+			void parallel(int count) {
+				workers.start(count);
+				allocate();
+			}
 
 			//virtual void presetLoaded(int preset) { }
 			//virtual void optionChanged(int param, int item) { }
@@ -3872,42 +6855,67 @@ namespace klang {
 				return -1; // not found
 			}
 
-			// pass to synth and notes
-			virtual event onControl(int index, float value) override {
-				control(index, value);
-				for (unsigned int n = 0; n < notes.count; n++)
-					if (notes[n]->stage != Note::Off)
-						notes[n]->onControl(index, value);
-			};
-
 			// pass to synth and notes
 			virtual event onMIDI(int status, int byte1, int byte2) override {
-				onMIDI(status, byte1, byte2);
-				for (unsigned int n = 0; n < notes.count; n++)
-					if (notes[n]->stage != Note::Off)
-						notes[n]->onMIDI(status, byte1, byte2);
+				Context::Scope scope(context);
+				midi(status, byte1, byte2);
+				notes.sounding([&](Note* note) { note->onMIDI(status, byte1, byte2); });
 			}
 
 			// pass to synth and notes
 			virtual event onPreset(int index) override {
+				Context::Scope scope(context);
 				preset(index);
-				for (unsigned int n = 0; n < notes.count; n++)
-					if (notes[n]->stage != Note::Off)
-						notes[n]->onPreset(index);
+				notes.sounding([&](Note* note) { note->onPreset(index); });
 			};
 
+			// pass to synth and notes
+			virtual void onSetup() override {
+				Context::Scope scope(context);
+				reserve(context.maxBlock);
+				setup();
+				snapshot.publish(controls);
+				for (unsigned int n = 0; n < notes.count; n++)
+					notes[n]->onSetup();
+			}
+
+			// pass to synth and notes (silencing any playing)
+			virtual void onRestart() override {
+				Context::Scope scope(context);
+				restart();
+				for (unsigned int n = 0; n < notes.count; n++) {
+					notes[n]->stop();
+					notes[n]->onRestart();
+					notes.update(n);
+				}
+			}
+
 			// assign and start note
 			virtual event noteOn(int pitch, float velocity) {
-				const int n = notes.assign();
-				if (n != -1)
+				Context::Scope scope(context);
+				const int n = notes.assign(pitch);
+				if (n != -1) {
 					notes[n]->start((float)pitch, velocity);
+					notes.started(n, pitch);
+				}
 			}
 
 			// trigger note off (release)
 			virtual event noteOff(int pitch, float velocity) {
-				for (unsigned int n = 0; n < notes.count; n++)
-					if (notes[n]->pitch == pitch && notes[n]->stage == Note::Sustain)
-						notes[n]->release(velocity);
+				Context::Scope scope(context);
+				notes.release(pitch, velocity);
+			}
+
+			// note on / off messages start and release notes
+			virtual void dispatch(const Event& event) override {
+				if (event.type == Event::MIDI) {
+					const int type = event.midi.status & 0xF0;
+					if (type == 0x90 && event.midi.byte2 > 0)
+						return noteOn(event.midi.byte1, event.midi.byte2 / 127.f);
+					if (type == 0x80 || type == 0x90)
+						return noteOff(event.midi.byte1, event.midi.byte2 / 127.f);
+				}
+				Effect::dispatch(event);
 			}
 
 			// post processing (see Effect::process)
@@ -3915,32 +6923,142 @@ namespace klang {
 			virtual void process(buffer buffer) override { Effect::process(buffer); }
 
 			virtual void process(float** buffers, int length, float* parameters = nullptr) {
-				klang::buffer left(buffers[0], length);
-				klang::buffer right(buffers[1], length);
-				klang::Stereo::buffer buffer(left, right);
+				if (length > bus.length)
+					reserve(length); // host block exceeds the configured maximum (allocates, once; see configure)
+				Context::Scope scope(context);
+				(void)debug.buffer; // per-thread (allocates on first use)
+				Realtime::Scope realtime;
 
-				// sync parameters
+				// sync parameters (changes only)
 				if (parameters) {
 					for (unsigned int c = 0; c < controls.size(); c++)
-						controls[c].set(parameters[c]);
+						if (parameters[c] != controls[c].value)
+							controls.exchange.write(c, parameters[c]);
 				}
+				receive();
 
-				// generate note audio
-				for (unsigned int n = 0; n < notes.count; n++) {
-					Note* note = notes[n];
-					if (note->stage != Note::Off) {
-						if (!note->process(buffer))
-							note->stop();
-					}
-				}
+				// render between queued events (sample-accurate; post processing sees each span whole)
+				split(length, [&](int offset, int length) {
+					generate(buffers, offset, length);
 
-				// apply post processing
-				this->process(buffer);
+					// apply post processing
+					klang::buffer left(buffers[0] + offset, length);
+					klang::buffer right(buffers[1] + offset, length);
+					klang::Stereo::buffer buffer(left, right);
+					this->process(buffer);
+				});
 
 				// sync update (changed by process())
 				if (parameters) {
 					for (unsigned int c = 0; c < controls.size(); c++)
-						parameters[c] = controls[c].value;
+						if (parameters[c] != controls[c].value)
+							parameters[c] = controls[c].value;
+				}
+			}
+
+		protected:
+			Workers workers;
+
+			// size voice buffers for blocks of up to length samples (allocates; call outside the render)
+			void reserve(int length) {
+				context.maxBlock = length;
+				notes.reserve(length);
+				bus.allocate(length);
+				allocate();
+			}
+
+			// per-voice scratch (left + right per voice, each 64-byte aligned)
+			struct {
+				float* samples = nullptr;
+				unsigned int capacity = 0;
+				int length = 0;      ///< samples per channel
+				int stride = 0;      ///< floats per channel (rounded up to a cache line)
+			} scratch;
+
+			// generate note audio (each voice to scratch, then mixed into the output in voice order; batched voices render first)
+			void generate(float** buffers, int offset, int length) {
+				assert(length <= notes.reserved);
+				notes.limit(length);
+				if (snapshot.publish(controls))
+					notes.sounding([&](Note* note) { note->changed(snapshot); });
+				notes.render(length);
+				bus.clear(length);
+				float* outL = buffers[0] + offset;
+				float* outR = buffers[1] + offset;
+				memset(outL, 0, sizeof(float) * length);
+				memset(outR, 0, sizeof(float) * length);
+				if (workers.size() && scratch.samples) {
+					assert(length <= scratch.length);
+					render(outL, outR, length);
+				} else {
+					for (unsigned int n = 0; n < notes.count; n++) {
+						Note* note = notes[n];
+						if (note->stage != Note::Off) {
+							klang::buffer left(bus.left(), length, 0.f);
+							klang::buffer right(bus.right(), length, 0.f);
+							klang::Stereo::buffer voice(left, right);
+							Random::Scope stream(note->prng);
+							const auto start = notes.clock();
+							const bool finished = !note->process(voice);
+							notes.measured(n, notes.elapsed(start), length);
+							if (finished || note->mix.fading || note->decayed(bus.left(), bus.right(), length))
+								note->stop();
+							bus.mix(note->mix, bus.left(), bus.right(), outL, outR, length);
+							notes.update(n);
+						}
+					}
+				}
+			}
+
+			void allocate() {
+				Pool::release(scratch.samples, scratch.capacity);
+				scratch = {};
+				if (!workers.size() || !notes.count)
+					return;
+				scratch.length = context.maxBlock;
+				scratch.stride = (scratch.length + 15) & ~15;
+				scratch.capacity = 2 * scratch.stride * notes.count;
+				scratch.samples = Pool::allocate(scratch.capacity);
+			}
+
+			// render active voices into their own scratch on the workers, then mix in voice order
+			void render(float* outL, float* outR, int length) {
+				int active[128];
+				bool finished[128];
+				float seconds[128];
+				int voices = 0;
+				for (unsigned int n = 0; n < notes.count; n++)
+					if (notes[n]->stage != Note::Off)
+						active[voices++] = n;
+
+				auto voice = [&](int v) {
+					const int n = active[v];
+					float* left = scratch.samples + 2 * n * scratch.stride;
+					float* right = left + scratch.stride;
+					klang::buffer l(left, length, 0.f);
+					klang::buffer r(right, length, 0.f);
+					klang::Stereo::buffer out(l, r);
+					const SampleRate previous = klang::fs; // thread's sample rate
+					klang::fs = context.fs;
+					(void)debug.buffer; // per-thread (allocates on first use)
+					Realtime::Scope realtime;
+					Random::Scope stream(notes[n]->prng);
+					const auto start = notes.clock();
+					finished[v] = !notes[n]->process(out);
+					seconds[v] = notes.elapsed(start);
+					klang::fs = previous;
+				};
+				workers.run(voices, voice);
+
+				for (int v = 0; v < voices; v++) {
+					const int n = active[v];
+					const float* left = scratch.samples + 2 * n * scratch.stride;
+					const float* right = left + scratch.stride;
+					bus.mix(notes[n]->mix, left, right, outL, outR, length);
+					notes.measured(n, seconds[v], length);
+					if (finished[v] || notes[n]->mix.fading || notes[n]->decayed(left, right, length))
+						notes[n]->stop();
+					notes.update(n);
 				}
 			}
 		};
@@ -3952,77 +7070,418 @@ namespace klang {
 	}
 	/// @endcond
 
-	/// Feed audio source to destination (with source processing)
-	template<typename SOURCE, typename DESTINATION>
-	inline DESTINATION& operator>>(SOURCE& source, DESTINATION& destination) {
-		if constexpr (is_derived_from<Input, DESTINATION>())
-			destination.input(source); // input to destination (enables overriding of <<)
-		else if constexpr (is_derived_from<Stereo::Input, DESTINATION>())
-			destination.input(source); // input to destination (enables overriding of <<)
-		else
-			destination << source; // copy to destination
-		return destination;
-	}
+	/// Batched synthesiser voices (LANES notes rendered as one object; per-voice state lives in lanes, e.g. Bank<Fast::Saw, LANES>)
+	template<int LANES>
+	struct Batch : Batched, Generic::Generator<signals<LANES>> {
+		using Generic::Generator<signals<LANES>>::out;
+		using Generic::Generator<signals<LANES>>::process;
+		static constexpr int lanes = LANES;
 
-	/// Feed audio source to destination (no source processing)
-	template<typename SOURCE, typename DESTINATION>
-	inline DESTINATION& operator>>(const SOURCE& source, DESTINATION& destination) {
-		if constexpr (is_derived_from<Input, DESTINATION>())
-			destination.input(source); // input to destination (enables overriding of <<)
-		else if constexpr (is_derived_from<Stereo::Input, DESTINATION>())
-			destination.input(source); // input to destination (enables overriding of <<)
-		else
-			destination << source; // copy to destination
-		return destination;
-	}
+		decltype(NoteBase<Synth>::controls) controls;
+		Pitch pitch[LANES];
+		Velocity velocity[LANES];
+		bool sounding[LANES] = { false };	// lanes with a playing note (others are not mixed)
 
-	/// Common audio generators / oscillators.
-	namespace Generators {
-		using namespace klang;
+		Batch() {}
+		virtual ~Batch() { Pool::release(rendered, LANES * capacity); }
 
-		/// Simple oscillators
-		namespace Basic {
-			/// Sine wave oscillator
-			struct Sine : public Oscillator {
-				void process() {
-					out = sin(position + offset);
-					position += increment;
-				}
-			};
+		virtual void prepare() {}
+		virtual void process() override = 0; // all lanes at once (out[lane])
 
-			/// Saw wave oscillator (aliased)
-			struct Saw : public Oscillator {
-				void process() {
-					out = position * pi.inv - 1.f;
-					position += increment;
-				}
-			};
+		// rendered samples of a lane (current block)
+		const float* output(int lane) const { return rendered + lane * capacity; }
 
-			/// Triangle wave oscillator (aliased)
-			struct Triangle : public Oscillator {
-				void process() {
-					out = abs(2.f * position * pi.inv - 2) - 1.f;
-					position += increment;
-				}
-			};
+		void reserve(int length) override {
+			if (length <= capacity)
+				return;
+			Pool::release(rendered, LANES * capacity);
+			capacity = (length + 15) & ~15;
+			rendered = Pool::allocate(LANES * capacity);
+		}
 
-			/// Square wave oscillator (aliased)
-			struct Square : public Oscillator {
-				void process() {
-					out = position > pi ? 1.f : -1.f;
-					position += increment;
+		void render(int length) override {
+			bool active = false;
+			for (int lane = 0; lane < LANES; lane++)
+				active |= sounding[lane];
+			if (!active)
+				return;
+
+			this->prepare();
+			signals<LANES> block[KLANG_BLOCK_SIZE];
+			for (int offset = 0; offset < length; offset += KLANG_BLOCK_SIZE) {
+				const int size = min(KLANG_BLOCK_SIZE, length - offset);
+				this->process(block, size);
+				for (int lane = 0; lane < LANES; lane++) {
+					float* samples = rendered + lane * capacity + offset;
+					for (int s = 0; s < size; s++)
+						samples[s] = block[s][lane];
 				}
-			};
+			}
+		}
 
-			/// Pulse wave oscillator (aliased)
-			struct Pulse : public Oscillator {
-				param duty = 0.5f;
+	protected:
+		virtual event on(int lane, Pitch p, Velocity v) {}
+		virtual event off(int lane, Velocity v) { stop(lane); }
 
-				using Oscillator::set;
-				void set(param frequency, param phase, param duty) {
-					set(frequency, phase);
-					Pulse::duty = duty;
-				}
+		// end the lane's note (e.g. once its envelope finishes)
+		void stop(int lane) { sounding[lane] = false; }
+
+		float* rendered = nullptr;
+		int capacity = 0;
+
+		/// @cond
+		// note standing in for one lane (allocated and filed by Notes)
+		template<class NOTE>
+		struct Lane : NOTE {
+			Batch* batch;
+			const int lane;
+
+			Lane(Batch* batch, int lane) : batch(batch), lane(lane) {}
+
+			void init() override { batch->controls.attach(this->getSynth()->controls, this->getSynth()->snapshot); }
+			bool stop(Velocity v = 0) override { batch->stop(lane); return NOTE::stop(v); }
+			void process() override {}
+
+		protected:
+			event on(Pitch p, Velocity v) override {
+				batch->pitch[lane] = p;
+				batch->velocity[lane] = v;
+				batch->sounding[lane] = true;
+				batch->on(lane, p, v);
+			}
+			event off(Velocity v) override {
+				batch->off(lane, v);
+				if (!batch->sounding[lane])
+					this->stage = NOTE::Off;
+			}
+
+			bool finish(float last) {
+				this->out = last; // level (for voice stealing)
+				if (!batch->sounding[lane])
+					this->stage = NOTE::Off;
+				return !this->finished();
+			}
+		};
+
+		struct MonoVoice : Lane<klang::Note> {
+			using Lane<klang::Note>::Lane;
+			bool process(klang::buffer buffer) override {
+				const float* samples = this->batch->output(this->lane);
+				signal* output = buffer.pointer();
+				const int length = buffer.remaining();
+				for (int s = 0; s < length; s++)
+					output[s] = samples[s];
+				return this->finish(length ? samples[length - 1] : 0.f);
+			}
+		};
+
+		struct StereoVoice : Lane<Stereo::Note> {
+			using Lane<Stereo::Note>::Lane;
+			bool process(Stereo::view buffer) override {
+				const float* samples = this->batch->output(this->lane);
+				klang::view left = buffer.left, right = buffer.right;
+				for (int s = 0; s < left.length; s++) {
+					left[s] += samples[s];
+					right[s] += samples[s];
+				}
+				return this->finish(left.length ? samples[left.length - 1] : 0.f);
+			}
+		};
+		/// @endcond
+
+	public:
+		template<class NOTE>
+		using Voice = std::conditional_t<std::is_base_of_v<Stereo::Note, NOTE>, StereoVoice, MonoVoice>;
+	};
+
+	/// Fused signal-flow expressions (lazy; a whole >> / arithmetic chain renders as one loop per block)
+	namespace Fused {
+
+		/// Expression node (CRTP; children held by value, objects by reference)
+		template<class NODE>
+		struct Expression {
+			const NODE& node() const { return static_cast<const NODE&>(*this); }
+
+			/// Render the expression to a block of samples (single fused loop)
+			void process(signal* output, int length) const {
+				const NODE& node = this->node();
+				for (int s = 0; s < length; s++)
+					output[s] = node.sample(s);
+			}
+
+			/// Run the expression for a block of samples (for side-effects only; e.g. taps, followers)
+			void process(int length) const {
+				const NODE& node = this->node();
+				for (int s = 0; s < length; s++)
+					node.sample(s);
+			}
+		};
+
+		/// @internal
+		template<class TYPE>
+		constexpr bool is_expression() { return std::is_base_of_v<Expression<TYPE>, TYPE>; }
+
+		/// @cond
+		// call process() on an object, bound by its declared type (no virtual call, if concrete)
+		template<class TYPE>
+		inline void process(TYPE& object) {
+			if constexpr (std::is_polymorphic_v<TYPE> && !std::is_abstract_v<TYPE>)
+				object.TYPE::process();
+			else
+				object.process();
+		}
+		/// @endcond
+
+		/// Block input (reads sample s of buffer)
+		struct Buffer : Expression<Buffer> {
+			const signal* input;
+			Buffer(const signal* input) : input(input) {}
+			signal sample(int s) const { return input[s]; }
+		};
+
+		/// Constant input (fixed for the block)
+		struct Scalar : Expression<Scalar> {
+			signal value;
+			Scalar(float value) : value(value) {}
+			signal sample(int) const { return value; }
+		};
+
+		/// Generator input (processed once per sample)
+		template<class TYPE>
+		struct Generate : Expression<Generate<TYPE>> {
+			TYPE& object;
+			Generate(TYPE& object) : object(object) {}
+			signal sample(int) const {
+				Fused::process(object);
+				return object.out;
+			}
+		};
+
+		/// Modifier stage (source >> object)
+		template<class SOURCE, class TYPE>
+		struct Modify : Expression<Modify<SOURCE, TYPE>> {
+			SOURCE source;
+			TYPE& object;
+			Modify(const SOURCE& source, TYPE& object) : source(source), object(object) {}
+			signal sample(int s) const {
+				const signal x = source.sample(s);
+				if constexpr (std::is_base_of_v<Generic::Modifier<signal>, TYPE>) {
+					object.in = x;
+					object.TYPE::input(); // input pre-processing (non-virtual)
+				} else {
+					object.input(x);
+				}
+				Fused::process(object);
+				return object.out;
+			}
+		};
+
+		/// Function stage (source >> function, lambda or function pointer; inlined where possible)
+		template<class SOURCE, class FUNCTION>
+		struct Map : Expression<Map<SOURCE, FUNCTION>> {
+			SOURCE source;
+			FUNCTION function;
+			Map(const SOURCE& source, FUNCTION function) : source(source), function(function) {}
+			signal sample(int s) const { return function(source.sample(s)); }
+		};
+
+		/// Signal tap (source >> destination; copies each sample, passes it through)
+		template<class SOURCE, class TYPE>
+		struct Tap : Expression<Tap<SOURCE, TYPE>> {
+			SOURCE source;
+			TYPE& destination;
+			Tap(const SOURCE& source, TYPE& destination) : source(source), destination(destination) {}
+			signal sample(int s) const {
+				const signal x = source.sample(s);
+				destination << x;
+				return x;
+			}
+		};
+
+		/// Arithmetic (left evaluated before right)
+		template<class LEFT, class RIGHT, class OPERATOR>
+		struct Binary : Expression<Binary<LEFT, RIGHT, OPERATOR>> {
+			LEFT left;
+			RIGHT right;
+			Binary(const LEFT& left, const RIGHT& right) : left(left), right(right) {}
+			signal sample(int s) const {
+				const signal x = left.sample(s);
+				return OPERATOR()(x, right.sample(s));
+			}
+		};
+
+		/// @cond
+		template<class TYPE, class = void> struct is_modifier : std::false_type {};
+		template<class TYPE> struct is_modifier<TYPE, std::void_t<decltype(std::declval<TYPE&>().in), decltype(std::declval<TYPE&>().out)>> : std::true_type {};
+
+		template<class TYPE, class = void> struct is_generator : std::false_type {};
+		template<class TYPE> struct is_generator<TYPE, std::void_t<decltype(std::declval<TYPE&>().out)>> : std::true_type {};
+		/// @endcond
+
+		/// Wrap a source as an expression (buffer, signal/value or generator/modifier object)
+		template<class TYPE>
+		inline auto input(TYPE&& source) {
+			using T = std::decay_t<TYPE>;
+			if constexpr (is_expression<T>())
+				return T(source);
+			else if constexpr (std::is_pointer_v<T>)
+				return Buffer(source);
+			else if constexpr (std::is_same_v<T, klang::buffer>)
+				return Buffer(source.pointer());
+			else if constexpr (is_generator<T>::value)
+				return Generate<T>(source);
+			else
+				return Scalar(float(source));
+		}
+
+		/// Stream expression to destination (modifier, function, signal/control tap, or buffer to render)
+		template<class NODE, class TYPE>
+		inline decltype(auto) operator>>(const Expression<NODE>& expression, TYPE&& destination) {
+			using T = std::remove_reference_t<TYPE>;
+			if constexpr (std::is_same_v<std::remove_cv_t<T>, klang::buffer>) {
+				expression.process(destination.pointer(), destination.remaining());
+				return (destination);
+			} else if constexpr (is_modifier<T>::value) {
+				return Modify<NODE, T>(expression.node(), destination);
+			} else if constexpr (std::is_invocable_r_v<float, std::decay_t<TYPE>&, float>) {
+				return Map<NODE, std::decay_t<TYPE>>(expression.node(), destination);
+			} else {
+				return Tap<NODE, T>(expression.node(), destination);
+			}
+		}
+
+		// arithmetic operations build expressions (evaluated per sample, in the fused loop)
+		template<class A, class B> inline auto operator+(const Expression<A>& a, const Expression<B>& b) { return Binary<A, B, std::plus<>>(a.node(), b.node()); }
+		template<class A, class B> inline auto operator*(const Expression<A>& a, const Expression<B>& b) { return Binary<A, B, std::multiplies<>>(a.node(), b.node()); }
+		template<class A, class B> inline auto operator-(const Expression<A>& a, const Expression<B>& b) { return Binary<A, B, std::minus<>>(a.node(), b.node()); }
+		template<class A, class B> inline auto operator/(const Expression<A>& a, const Expression<B>& b) { return Binary<A, B, std::divides<>>(a.node(), b.node()); }
+
+		template<class A> inline auto operator+(const Expression<A>& a, float b) { return a + Scalar(b); }
+		template<class A> inline auto operator*(const Expression<A>& a, float b) { return a * Scalar(b); }
+		template<class A> inline auto operator-(const Expression<A>& a, float b) { return a - Scalar(b); }
+		template<class A> inline auto operator/(const Expression<A>& a, float b) { return a / Scalar(b); }
+
+		template<class B> inline auto operator+(float a, const Expression<B>& b) { return Scalar(a) + b; }
+		template<class B> inline auto operator*(float a, const Expression<B>& b) { return Scalar(a) * b; }
+		template<class B> inline auto operator-(float a, const Expression<B>& b) { return Scalar(a) - b; }
+		template<class B> inline auto operator/(float a, const Expression<B>& b) { return Scalar(a) / b; }
+	};
+
+	/// Start a fused expression (e.g. fuse(input) >> lpf >> abs >> envelope; expression.process(output, length))
+	template<class TYPE>
+	inline auto fuse(TYPE&& source) { return Fused::input(std::forward<TYPE>(source)); }
+
+	/// Feed audio source to destination (with source processing)
+	template<typename SOURCE, typename DESTINATION, typename = std::enable_if_t<!Fused::is_expression<std::remove_cv_t<SOURCE>>()>>
+	inline DESTINATION& operator>>(SOURCE& source, DESTINATION& destination) {
+		if constexpr (is_derived_from<Input, DESTINATION>())
+			destination.input(source); // input to destination (enables overriding of <<)
+		else if constexpr (is_derived_from<Stereo::Input, DESTINATION>())
+			destination.input(source); // input to destination (enables overriding of <<)
+		else
+			destination << source; // copy to destination
+		return destination;
+	}
+
+	/// Feed audio source to destination (no source processing)
+	template<typename SOURCE, typename DESTINATION, typename = std::enable_if_t<!Fused::is_expression<std::remove_cv_t<SOURCE>>()>>
+	inline DESTINATION& operator>>(const SOURCE& source, DESTINATION& destination) {
+		if constexpr (is_derived_from<Input, DESTINATION>())
+			destination.input(source); // input to destination (enables overriding of <<)
+		else if constexpr (is_derived_from<Stereo::Input, DESTINATION>())
+			destination.input(source); // input to destination (enables overriding of <<)
+		else
+			destination << source; // copy to destination
+		return destination;
+	}
+
+	/// Feed audio source through a stateless function (with source processing; see Mapping)
+	template<typename SOURCE, class FUNCTION, typename = std::enable_if_t<!Fused::is_expression<std::remove_cv_t<SOURCE>>()>>
+	inline signal operator>>(SOURCE& source, const Mapping<FUNCTION>& mapping) { return mapping(source); }
+
+	/// Feed audio source through a stateless function (no source processing; see Mapping)
+	template<typename SOURCE, class FUNCTION, typename = std::enable_if_t<!Fused::is_expression<std::remove_cv_t<SOURCE>>()>>
+	inline signal operator>>(const SOURCE& source, const Mapping<FUNCTION>& mapping) { return mapping(source); }
+
+	/// Common audio generators / oscillators.
+	namespace Generators {
+		using namespace klang;
+
+		/// Simple oscillators
+		namespace Basic {
+			/// Sine wave oscillator
+			struct Sine : public Oscillator {
+				void process() {
+					out = sin(position + offset);
+					position += increment;
+				}
+
+				void process(signal* output, int length) {
+					for (int s = 0; s < length; s++) {
+						output[s] = sin(position + offset);
+						position += increment;
+					}
+					if (length > 0) out = output[length - 1];
+				}
+			};
+
+			/// Saw wave oscillator (aliased)
+			struct Saw : public Oscillator {
+				void process() {
+					out = position * pi.inv - 1.f;
+					position += increment;
+				}
+
+				void process(signal* output, int length) {
+					for (int s = 0; s < length; s++) {
+						output[s] = position * pi.inv - 1.f;
+						position += increment;
+					}
+					if (length > 0) out = output[length - 1];
+				}
+			};
+
+			/// Triangle wave oscillator (aliased)
+			struct Triangle : public Oscillator {
+				void process() {
+					out = abs(2.f * position * pi.inv - 2) - 1.f;
+					position += increment;
+				}
+
+				void process(signal* output, int length) {
+					for (int s = 0; s < length; s++) {
+						output[s] = abs(2.f * position * pi.inv - 2) - 1.f;
+						position += increment;
+					}
+					if (length > 0) out = output[length - 1];
+				}
+			};
+
+			/// Square wave oscillator (aliased)
+			struct Square : public Oscillator {
+				void process() {
+					out = position > pi ? 1.f : -1.f;
+					position += increment;
+				}
+
+				void process(signal* output, int length) {
+					for (int s = 0; s < length; s++) {
+						output[s] = position > pi ? 1.f : -1.f;
+						position += increment;
+					}
+					if (length > 0) out = output[length - 1];
+				}
+			};
+
+			/// Pulse wave oscillator (aliased)
+			struct Pulse : public Oscillator {
+				param duty = 0.5f;
+
+				using Oscillator::set;
+				void set(param frequency, param phase, param duty) {
+					set(frequency, phase);
+					Pulse::duty = duty;
+				}
 
 				void process() {
 					out = position > (duty * pi) ? 1.f : -1.f;
@@ -4032,8 +7491,14 @@ namespace klang {
 
 			/// White noise generator
 			struct Noise : public Generator {
+				Random prng; ///< per-object stream (seed for repeatable noise)
+
 				void process() {
-					out = rand() * 2.f / (const float)RAND_MAX - 1.f;
+					out = prng.draw(-1.f, 1.f); // (same stream as the block fill)
+				}
+
+				void process(signal* output, int length) override {
+					prng.bipolar((float*)output, length);
 				}
 			};
 		};
@@ -4218,6 +7683,50 @@ namespace klang {
 				return polysin(x);
 			}
 
+			/// @cond
+			// a if condition, else b (bitwise, so loops stay branch-free under strict floating point)
+			inline static float choose(bool condition, float a, float b) {
+				unsigned int i, j;
+				memcpy(&i, &a, sizeof(float));
+				memcpy(&j, &b, sizeof(float));
+				const unsigned int mask = 0u - (unsigned int)condition;
+				i = (i & mask) | (j & ~mask);
+				memcpy(&a, &i, sizeof(float));
+				return a;
+			}
+			/// @endcond
+
+			/// fast sine for a block of integer phases (same results as fastsinp(p), without branches; vectorises)
+			inline static void fastsinp(const unsigned int* phase, float* output, int length) {
+				constexpr float half = pi / 2.f, threeHalves = 3.f / 2.f * pi, whole = pi;
+				for (int s = 0; s < length; s++) {
+					const float x = float(int(phase[s] >> 9)) * (1.f / 8388608.f) * twoPi; // = fast_modp(phase[s])
+					float y = choose(x > half, whole - x, x);		// pi/2 ... 3pi/2 (mirrored)
+					y = choose(x > threeHalves, x - twoPi, y);		// 3/2pi ... 2pi (translated)
+					output[s] = polysin(y);
+				}
+			}
+
+			/// Render a block of sine from an integer phase (advanced by delta per sample), plus optional phase modulation (radians, per sample)
+			inline static void sines(unsigned int& phase, unsigned int shift, unsigned int delta, float* output, int length, const float* modulation = nullptr) {
+				constexpr float turns = float(1.0 / (2.0 * 3.1415926535897932384626433832795));
+				unsigned int phases[KLANG_BLOCK_SIZE];
+				for (int start = 0; start < length; start += KLANG_BLOCK_SIZE) {
+					const int n = length - start < KLANG_BLOCK_SIZE ? length - start : KLANG_BLOCK_SIZE;
+					for (int s = 0; s < n; s++)
+						phases[s] = phase + shift + (unsigned int)s * delta;
+					if (modulation) {
+						for (int s = 0; s < n; s++) {
+							float t = modulation[start + s] * turns;
+							t -= floorf(t + 0.5f); // [-0.5, 0.5) turns
+							phases[s] += (unsigned int)(int)(t * 4294967296.f);
+						}
+					}
+					fastsinp(phases, output + start, n);
+					phase += (unsigned int)n * delta;
+				}
+			}
+
 			/// Sine wave oscillator (band-limited, optimised)
 			struct Sine : public Oscillator {
 				void reset() override {
@@ -4253,9 +7762,22 @@ namespace klang {
 					position += increment;
 				}
 
+				void process(signal* output, int length) override {
+					sines(position.position, offset.position, increment.amount, (float*)output, length);
+					if (length > 0) out = output[length - 1];
+				}
+
+				/// Render a block with phase modulation (radians per sample; e.g. for FM)
+				void process(const float* modulation, signal* output, int length) {
+					sines(position.position, offset.position, increment.amount, (float*)output, length, modulation);
+					if (length > 0) out = output[length - 1];
+				}
+
 			protected:
 				Fast::Increment increment;
 				Fast::Phase position, offset;
+
+				template<typename, int, typename> friend struct klang::Bank;
 			};
 
 			/// Oscillator State Machine
@@ -4374,7 +7896,7 @@ namespace klang {
 				//	return y + 1.f;
 				//}
 
-				float saw() { return saw(offset - col, tick()); }
+				float saw() { const float p = offset - col; return saw(p, tick()); } // (phase before the tick)
 				inline float saw(const float p, const State state) const {
 					// state machine action
 					switch (state) {
@@ -4388,7 +7910,7 @@ namespace klang {
 					}
 				}
 
-				float pulse() { return pulse(offset, tick()); }
+				float pulse() { const float p = offset; return pulse(p, tick()); }
 				inline float pulse(const float p, const State state) const {
 					// state machine action
 					switch (state) {
@@ -4425,9 +7947,26 @@ namespace klang {
 					out = osm.output();
 				}
 
+				void process(signal* output, int length) {
+					constexpr OSM::Waveform saw = &OSM::saw, pulse = &OSM::pulse;
+					if (osm.waveform == saw) {
+						for (int s = 0; s < length; s++)
+							output[s] = osm.saw();
+					} else if (osm.waveform == pulse) {
+						for (int s = 0; s < length; s++)
+							output[s] = osm.pulse();
+					} else {
+						for (int s = 0; s < length; s++)
+							output[s] = osm.output();
+					}
+					if (length > 0) out = output[length - 1];
+				}
+
 			protected:
 				using Oscillator::set;
 				OSM osm;
+
+				template<typename, int, typename> friend struct klang::Bank;
 			};
 			/// @endcond
 
@@ -4442,13 +7981,14 @@ namespace klang {
 
 			/// White noise generator (optimised)
 			struct Noise : public Generator {
-				static constexpr unsigned int bias = 0b1000011100000000000000000000000;
-				/// @cond
-				union { unsigned int i; float f; };
-				/// @endcond
+				Random prng; ///< per-object stream (seed for repeatable noise)
+
 				void process() {
-					i = ((rand() & 0b111111111111111UL) << 1) | bias;
-					out = f - 257.f;
+					out = prng.draw(-1.f, 1.f); // (same stream as the block fill)
+				}
+
+				void process(signal* output, int length) override {
+					prng.bipolar((float*)output, length);
 				}
 			};
 		};
@@ -4457,12 +7997,12 @@ namespace klang {
 		namespace Wavetables {
 			/// Sine wave oscillator (wavetable)
 			struct Sine : public Wavetable {
-				Sine() : Wavetable(Basic::Sine()) {}
+				Sine() : Wavetable(Mipmap::shared<Basic::Sine>()) {}
 			};
 
 			/// Saw wave oscillator (wavetable)
 			struct Saw : public Wavetable {
-				Saw() : Wavetable(Basic::Saw()) {}
+				Saw() : Wavetable(Mipmap::shared<Basic::Saw>()) {}
 			};
 		}
 	};
@@ -4470,21 +8010,118 @@ namespace klang {
 	/// Common audio filters.
 	namespace Filters {
 
-		//		namespace Basic {
+		/// Simple DC filter / blocker
+		struct DCF : public Modifier {
+			float r = 0.995f; // Decay factor (adjustable)
+			float z = 0;	  // Filter state (last input)
+
+			void set(float r) { this->r = r; }
 
-					/// Basic one-pole IIR filter.
+			void process() {
+				out = in - z + r * out;
+				z = in;
+			}
+
+			void process(const signal* input, signal* output, int length) {
+				float x = in, y = out;
+				for (int s = 0; s < length; s++) {
+					x = input[s];
+					y = x - z + r * y;
+					z = x;
+					output[s] = y;
+				}
+				in = x; out = y;
+			}
+		};
+
+		/// IIR filter for specified order
+		template<int ORDER>
 		struct IIR : public Modifier {
 			virtual ~IIR() {}
 
-			float a, b;
+			float a[ORDER] = { }; // Feedback coefficients (a1, a2, ..., aN)
+			float y[ORDER] = { }; // Previous outputs (y[n-1], y[n-2], ..., y[n-N])
+
+			template <typename... Coeffs>
+			void set(Coeffs... coeffs) {
+				static_assert(sizeof...(coeffs) == ORDER, "Incorrect number of coefficients.");
+				_set<0>(coeffs...);
+			}
+
+			void process() {
+				out = in;
+				for (size_t i = 0; i < ORDER; ++i)
+					out -= a[i] * y[i];
+
+				for (size_t i = ORDER - 1; i > 0; --i)
+					y[i] = y[i - 1];
+				y[0] = out;
+			}
+
+			void process(const signal* input, signal* output, int length) {
+				for (int s = 0; s < length; s++) {
+					float x = input[s];
+					for (size_t i = 0; i < ORDER; ++i)
+						x -= a[i] * y[i];
+
+					for (size_t i = ORDER - 1; i > 0; --i)
+						y[i] = y[i - 1];
+					output[s] = y[0] = x;
+				}
+				if (length > 0) {
+					in = input[length - 1];
+					out = y[0];
+				}
+			}
+
+		protected:
+			// Helper function to unpack variadic arguments into a[]
+			template <size_t index, typename First, typename... Rest>
+			void _set(First first, Rest... rest) {
+				a[index] = first;
+				if constexpr (index + 1 < ORDER)
+					_set<index + 1>(rest...);
+			}
+		};
+		
+		// optimised first-order IIR
+		template <>
+		struct IIR<1> : public Modifier {
+			virtual ~IIR() {}
+
+			float a = 1, b = 0; // Feedback coefficients (a1, a2)
 
 			void set(param coeff) {
 				a = coeff;
-				b = 1 - a;
+				b = 1.f - a;
 			}
 
 			void process() {
-				out = (a * in) + (b * out);
+				out = in * a + out * b;
+			}
+
+			void process(const signal* input, signal* output, int length) {
+				float y = out;
+				for (int s = 0; s < length; s++)
+					output[s] = y = input[s] * a + y * b;
+				if (length > 0) in = input[length - 1];
+				out = y;
+			}
+
+			/// Compute the phase offset in seconds at a given frequency
+			float phase(float f) const {
+				float omega = 2.0f * pi.f * f / fs.f;
+				float cos_w = cosf(omega);
+				float sin_w = sinf(omega);
+
+				return atan2(b * sin_w, 1.f - b * cos_w) / (2.0f * pi.f * f); // Convert to seconds
+			}
+
+			/// Compute the group delay in samples at a given frequency
+			float delay(float f) const {
+				const float omega = 2.0f * pi.f * f / fs.f;
+				const float cos_w = cosf(omega);
+				return (1.f - a * a) / (1.f - 2.f * a * cos_w + a * a);
 			}
 		};
 
@@ -4515,7 +8152,6 @@ namespace klang {
 				void set(param f) {
 					if (Filter::f != f) {
 						Filter::f = f;
-						//tan0 = tanf(0.5f * f * fs.w);
 						init();
 					}
 				}
@@ -4523,7 +8159,19 @@ namespace klang {
 				virtual void init() = 0;
 
 				void process() {
-					out = b0 * in + b1 * z + a1 * out + DENORMALISE;
+					out = b0 * in + b1 * z + a1 * out;
+					z = in;
+				}
+
+				void process(const signal* input, signal* output, int length) {
+					float x = in, y = out;
+					for (int s = 0; s < length; s++) {
+						x = input[s];
+						y = b0 * x + b1 * z + a1 * y;
+						z = x;
+						output[s] = y;
+					}
+					in = x; out = y;
 				}
 			};
 
@@ -4538,7 +8186,28 @@ namespace klang {
 				}
 
 				void process() {
-					out = b0 * in + a1 * out + DENORMALISE;
+					out = b0 * in + a1 * out;
+				}
+
+				void process(const signal* input, signal* output, int length) {
+					float y = out;
+					for (int s = 0; s < length; s++)
+						output[s] = y = b0 * input[s] + a1 * y;
+					if (length > 0) in = input[length - 1];
+					out = y;
+				}
+
+				/// Compute the phase delay in seconds at a given frequency
+				float phase(float f) const {
+					float omega = 2.0f * pi.f * f / fs.f;
+					float cos_w = cosf(omega);
+					float sin_w = sinf(omega);
+
+					float real = b0 - a1 * cos_w;
+					float imag = -a1 * sin_w;
+
+					float phaseRadians = atan2f(imag, real);
+					return phaseRadians / (2.0f * pi.f * f); // Convert to seconds
 				}
 			};
 
@@ -4555,25 +8224,6 @@ namespace klang {
 			};
 		};
 
-		/// One-pole Butterworth filter.
-		namespace Butterworth {
-			/// Low-pass filter (LPF).
-			struct LPF : OnePole::Filter {
-				virtual ~LPF() {}
-
-				void init() {
-					const float c = 1.f / tanf(pi * f * fs.inv);
-					constant a0 = { 1.f + c };
-					b0 = a0.inv;  // b0 == b1
-					a1 = (1.f - c) * a0.inv; // = (1-c) / a0
-				}
-				void process() {
-					out = b0 * (in + z) - a1 * out;// +DENORMALISE;
-					z = in;
-				}
-			};
-		};
-
 		/// Transposed Direct Form II Biquadratic Filter
 		namespace Biquad {
 
@@ -4602,8 +8252,20 @@ namespace klang {
 					z[0] = z[1] = 0;
 				}
 
-				/// Set the filter cutoff (and Q)
-				void set(param f, param Q = root2.inv) {
+				/// Set the filter cutoff (default Q)
+				void set(param f) { this->set(f, root2.inv); }
+
+				/// Set the filter cutoff and bandwidth
+				void set(param f, relative bw) {
+					if (bw > 0)
+						this->set(f, param(f / bw));
+				}
+
+				/// Set the filter cutoff and Q
+				void set(param f, param Q) {
+					if (Q < 0) // treat negative Q as bandwidth
+						Q = f / -Q;
+
 					if (Filter::f != f || Filter::Q != Q) {
 						Filter::f = f;
 						Filter::Q = Q;
@@ -4614,7 +8276,7 @@ namespace klang {
 
 						if (Q < 0.5) Q = 0.5;
 						a = sin0 / (2.f * Q);
-						init();
+						this->init();
 					}
 				}
 
@@ -4629,13 +8291,66 @@ namespace klang {
 					z[1] = b2 * in - a2 * y;
 					out = y;
 				}
-			};
 
-			/// Low-pass filter (LPF)
-			struct LPF : Filter {
-				virtual ~LPF() {}
+				/// Apply the biquad filter to a block of samples (Transposed Direct Form II)
+				void process(const signal* input, signal* output, int length) noexcept {
+					float z0 = z[0], z1 = z[1], x = in, y = out;
+					for (int s = 0; s < length; s++) {
+						x = input[s];
+						y = b0 * x + z0;
+						z0 = b1 * x - a1 * y + z1;
+						z1 = b2 * x - a2 * y;
+						output[s] = y;
+					}
+					z[0] = z0; z[1] = z1;
+					in = x; out = y;
+				}
 
-				void init() override {
+				/// Return the phase offset for the specified frequency (in seconds)
+				float phase(float f) const
+				{
+					float omega = 2.0f * pi.f * f / fs.f;
+					float cos_w = std::cos(omega);
+					float sin_w = std::sin(omega);
+
+					float real = b0 + b1 * cos_w + b2 * cos(2 * omega);// -(a1 * cos_w + a2 * cos(2 * omega));
+					float imag =      b1 * sin_w + b2 * sin(2 * omega);// -(a1 * sin_w + a2 * sin(2 * omega));
+					float phaseRadians = std::atan2(-imag, real);
+
+					real = 1 + (a1 * cos_w + a2 * cos(2 * omega));
+					imag = (a1 * sin_w + a2 * sin(2 * omega));
+
+					phaseRadians -= std::atan2(-imag, real);
+					return phaseRadians / (2.0f * pi.f * f); // Convert to seconds
+				}
+
+				/// Return the group delay for the specified frequency (in samples)
+				float delay(float f) const
+				{
+					float omega = 2.0f * pi.f * f / fs.f;
+					float cos_w = std::cos(omega);
+					float sin_w = std::sin(omega);
+
+					// Compute transfer function components
+					float R = b0 + b1 * cos_w + b2 * cos(2 * omega) - (a1 * cos_w + a2 * cos(2 * omega));
+					float I =      b1 * sin_w + b2 * sin(2 * omega) - (a1 * sin_w + a2 * sin(2 * omega));
+
+					// Compute phase response
+					//float phaseRadians = std::atan2(I, R);
+
+					// Compute the derivative of phase (group delay)
+					float dR_dOmega = -b1 * sin_w - 2 * b2 * sin(2 * omega) + a1 * sin_w + 2 * a2 * sin(2 * omega);
+					float dI_dOmega =  b1 * cos_w + 2 * b2 * cos(2 * omega) - a1 * cos_w - 2 * a2 * cos(2 * omega);
+
+					return (R * dI_dOmega - I * dR_dOmega) / (R * R + I * I);
+				}
+			};
+
+			/// Low-pass filter (LPF)
+			struct LPF : Filter {
+				virtual ~LPF() {}
+
+				void init() override {
 					constant a0 = { 1.f + a };
 					a1 = a0.inv * (-2.f * cos0);
 					a2 = a0.inv * (1.f - a);
@@ -4723,17 +8438,536 @@ namespace klang {
 
 			/// All-pass filter (APF)
 			struct APF : Filter {
+				param r = 1.f;
+
+				/// Set the filter cutoff (default r)
+				void set(param f) { this->set(f, 1.f); }
+
+				/// Set the pole frequency and radius (r)
+				void set(param f, param r) {
+					if (Filter::f != f || a != r) {
+						Filter::f = f;
+						a = r;
+
+						const float w = f * fs.w;
+						cos0 = cosf(w);
+						sin0 = sinf(w);
+						
+						init();
+					}
+				}
+
 				void init() {
-					constant a0 = { 1.f + a };
-					b1 = a1 = a0.inv * (-2.f * cos0);
-					b0 = a2 = a0.inv * (1.f - a);
+					float omega = 2.0f * pi * f / fs;
+					float cos0 = cos(omega);
+
+					b0 = a2 = a * a;
+					b1 = a1 = (-2.f * a * cos0);
 					b2 = 1.f;
 				}
 			};
 		}
 		//		}
+	
+		/// One-pole Butterworth filter.
+		namespace Butterworth {
+			/// Low-pass filter (LPF).
+			template<int ORDER>
+			struct LPF : OnePole::Filter {
+				virtual ~LPF() {}
+			};
+
+			template<>
+			struct LPF<1> : OnePole::Filter {
+				virtual ~LPF() {}
+
+				void init() {
+					const float c = 1.f / tanf(pi * f * fs.inv);
+					constant a0 = { 1.f + c };
+					b0 = a0.inv;  // b0 == b1
+					a1 = (1.f - c) * a0.inv; // = (1-c) / a0
+				}
+				void process() {
+					out = b0 * (in + z) - a1 * out;
+					z = in;
+				}
+
+				void process(const signal* input, signal* output, int length) {
+					float x = in, y = out;
+					for (int s = 0; s < length; s++) {
+						x = input[s];
+						y = b0 * (x + z) - a1 * y;
+						z = x;
+						output[s] = y;
+					}
+					in = x; out = y;
+				}
+			};
+
+			template<>
+			struct LPF<2> : Biquad::Filter {
+				void init() {
+					constant a0 = { 1.f + a };
+					b0 = a0.inv * ((1.f - cos0) / 2.f);
+					b1 = a0.inv * (1.f - cos0);
+					b2 = a0.inv * ((1.f - cos0) / 2.f);
+					a1 = a0.inv * ( - 2.f * cos0);
+					a2 = a0.inv * (1.f - a);
+				}
+			};
+		};
 	}
 
+	/// Common audio modifiers.
+	namespace Modifiers {
+		/// Modal resonator
+		struct Modal : public Modifier {
+			float a1 = 0, a2 = 0;
+			float y1 = 0, y2 = 0;
+
+			float gain = 0.05f;
+
+			// initialise the resonator
+			void set(param f, param decay, param gain) {
+				set(f, decay);
+				this->gain = std::clamp(gain.value * 0.05f, -0.05f, 0.05f);
+			}
+
+			void set(param f, param decay) {
+				gain = 0.05f;
+
+				constexpr float min_d = 1e-6f;  // Prevents underflow
+				constexpr float max_d = 0.9999f;  // Ensures stability
+			
+				const float w = f.value * fs.w;
+				const float d = std::clamp(std::exp(-pi / (decay * fs)), min_d, max_d);
+
+				a1 = 2.f * d * std::clamp(std::cos(w), -0.9999f, 0.9999f);
+				a2 = -d * d;
+
+				y2 = 0;
+				y1 = 0;
+				in = 0;
+				out = 0;
+			}
+
+			void input() {
+				in *= gain;
+			}
+
+			void process() {
+				out = in + a1 * y1 + a2 * y2;
+				y2 = y1;
+				y1 = out;
+				in = 0;
+			}
+
+			void process(const signal* input, signal* output, int length) {
+				for (int s = 0; s < length; s++) {
+					const float y = input[s] * gain + a1 * y1 + a2 * y2;
+					y2 = y1;
+					y1 = y;
+					output[s] = y;
+				}
+				if (length > 0) out = y1;
+				in = 0;
+			}
+		};
+	};
+
+	/// Statically-dispatched audio objects (CRTP; process() resolved at compile time, so >> chains inline)
+	namespace Static {
+
+		/// Audio output object (static dispatch)
+		template<class DERIVED, typename SIGNAL = klang::signal>
+		struct Output {
+			SIGNAL out = { 0.f };
+
+			// returns previous output (without processing)
+			const SIGNAL& output() const { return out; }
+
+			// returns output (with processing)
+			operator const SIGNAL& () { derived().process(); return out; } // return processed output
+			operator const SIGNAL& () const { return out; } // return last output
+
+			void reset() { out = 0; }
+
+		protected:
+			DERIVED& derived() { return static_cast<DERIVED&>(*this); }
+		};
+
+		// arithmetic operations produce copies
+		template<class DERIVED, typename SIGNAL> inline SIGNAL operator+(float other, Output<DERIVED, SIGNAL>& output) { return SIGNAL(output) + other; }
+		template<class DERIVED, typename SIGNAL> inline SIGNAL operator*(float other, Output<DERIVED, SIGNAL>& output) { return SIGNAL(output) * other; }
+		template<class DERIVED, typename SIGNAL> inline SIGNAL operator-(float other, Output<DERIVED, SIGNAL>& output) { return SIGNAL(other) - SIGNAL(output); }
+		template<class DERIVED, typename SIGNAL> inline SIGNAL operator/(float other, Output<DERIVED, SIGNAL>& output) { return SIGNAL(other) / SIGNAL(output); }
+
+		template<class DERIVED, typename SIGNAL> inline SIGNAL operator+(Output<DERIVED, SIGNAL>& output, float other) { return SIGNAL(output) + other; }
+		template<class DERIVED, typename SIGNAL> inline SIGNAL operator*(Output<DERIVED, SIGNAL>& output, float other) { return SIGNAL(output) * other; }
+		template<class DERIVED, typename SIGNAL> inline SIGNAL operator-(Output<DERIVED, SIGNAL>& output, float other) { return SIGNAL(output) - other; }
+		template<class DERIVED, typename SIGNAL> inline SIGNAL operator/(Output<DERIVED, SIGNAL>& output, float other) { return SIGNAL(output) / other; }
+
+		template<class A, class B, typename SIGNAL> inline SIGNAL operator+(Output<A, SIGNAL>& a, Output<B, SIGNAL>& b) { return SIGNAL(a) + SIGNAL(b); }
+		template<class A, class B, typename SIGNAL> inline SIGNAL operator*(Output<A, SIGNAL>& a, Output<B, SIGNAL>& b) { return SIGNAL(a) * SIGNAL(b); }
+		template<class A, class B, typename SIGNAL> inline SIGNAL operator-(Output<A, SIGNAL>& a, Output<B, SIGNAL>& b) { return SIGNAL(a) - SIGNAL(b); }
+		template<class A, class B, typename SIGNAL> inline SIGNAL operator/(Output<A, SIGNAL>& a, Output<B, SIGNAL>& b) { return SIGNAL(a) / SIGNAL(b); }
+
+		/// Signal generator object (static dispatch)
+		template<class DERIVED, typename SIGNAL = klang::signal>
+		struct Generator : public Output<DERIVED, SIGNAL> {
+			using Output<DERIVED, SIGNAL>::out;
+
+			// inline parameter(s) support (DERIVED::set)
+			template<typename... params>
+			DERIVED& operator()(params... p) {
+				this->derived().set(p...); return this->derived();
+			}
+
+			// block processing (default: per-sample, with DERIVED::process() inlined)
+			void process(SIGNAL* output, int length) {
+				for (int s = 0; s < length; s++) {
+					this->derived().process();
+					output[s] = out;
+				}
+			}
+		};
+
+		/// Signal modifier object (static dispatch)
+		template<class DERIVED, typename SIGNAL = klang::signal>
+		struct Modifier : public Output<DERIVED, SIGNAL> {
+			using Output<DERIVED, SIGNAL>::out;
+			SIGNAL in = { 0.f };
+
+			// retrieve current input
+			const SIGNAL& input() const { return in; }
+
+			// feed input (e.g. source >> modifier)
+			void input(const SIGNAL& source) { in = source; }
+			DERIVED& operator<<(const SIGNAL& source) { in = source; return this->derived(); }
+
+			// inline parameter(s) support (DERIVED::set)
+			template<typename... params>
+			DERIVED& operator()(params... p) {
+				this->derived().set(p...); return this->derived();
+			}
+
+			void process() { out = in; } // default to pass-through
+
+			// block processing (default: per-sample, with DERIVED::process() inlined; supports input == output)
+			void process(const SIGNAL* input, SIGNAL* output, int length) {
+				for (int s = 0; s < length; s++) {
+					in = input[s];
+					this->derived().process();
+					output[s] = out;
+				}
+			}
+		};
+
+		/// Optimised oscillators (static dispatch)
+		namespace Fast {
+			using Generators::Fast::OSM;
+			using Generators::Fast::fastsinp;
+			using Generators::Fast::twoPi;
+
+			/// Sine wave oscillator (band-limited, optimised)
+			struct Sine : public Generator<Sine> {
+				void reset() {
+					position.position = 0;
+					offset.position = 0;
+					out = 0;
+				}
+
+				void set(param frequency) {
+					if (frequency != Sine::frequency) {
+						Sine::frequency = frequency;
+						increment.set(frequency);
+					}
+				}
+
+				void set(param frequency, param phase) { // set frequency and phase
+					position = klang::Phase(phase);
+					offset.position = 0;
+					set(frequency);
+				}
+
+				void set(param frequency, relative phase) { // set frequency and phase
+					set(frequency);
+					set(phase);
+				}
+
+				void set(relative phase) { // set phase offset
+					offset = klang::Phase(phase * twoPi);
+				}
+
+				void process() {
+					out = fastsinp(position.position + offset.position);
+					position += increment;
+				}
+
+				void process(signal* output, int length) {
+					Generators::Fast::sines(position.position, offset.position, increment.amount, (float*)output, length);
+					if (length > 0) out = output[length - 1];
+				}
+
+				/// Render a block with phase modulation (radians per sample; e.g. for FM)
+				void process(const float* modulation, signal* output, int length) {
+					Generators::Fast::sines(position.position, offset.position, increment.amount, (float*)output, length, modulation);
+					if (length > 0) out = output[length - 1];
+				}
+
+			protected:
+				param frequency = 0; // cached to optimise updates
+				Generators::Fast::Increment increment;
+				Generators::Fast::Phase position, offset;
+			};
+
+			/// @cond
+			template<class DERIVED>
+			struct Osm : public Generator<DERIVED> {
+				Osm(OSM::Waveform waveform, float duty) : osm(waveform) { osm.setDuty(duty); }
+
+				void set(param frequency) { osm.set(frequency); }
+				void set(param frequency, param phase) { osm.set(frequency, phase); }
+				void set(param frequency, param phase, param duty) { osm.set(frequency, phase, duty); }
+
+			protected:
+				OSM osm;
+
+				// render block (waveform resolved at compile time)
+				template<float (OSM::*WAVEFORM)()>
+				void render(signal* output, int length) {
+					for (int s = 0; s < length; s++)
+						output[s] = (osm.*WAVEFORM)();
+					if (length > 0) this->out = output[length - 1];
+				}
+			};
+			/// @endcond
+
+			/// Saw wave oscillator (band-limited, optimised)
+			struct Saw : public Osm<Saw> {
+				Saw() : Osm(&OSM::saw, 0.f) {}
+				void process() { out = osm.saw(); }
+				void process(signal* output, int length) { render<&OSM::saw>(output, length); }
+			};
+
+			/// Triangle wave oscillator (band-limited, optimised)
+			struct Triangle : public Osm<Triangle> {
+				Triangle() : Osm(&OSM::saw, 1.f) {}
+				void process() { out = osm.saw(); }
+				void process(signal* output, int length) { render<&OSM::saw>(output, length); }
+			};
+
+			/// Square wave oscillator (band-limited, optimised)
+			struct Square : public Osm<Square> {
+				Square() : Osm(&OSM::pulse, 1.f) {}
+				void process() { out = osm.pulse(); }
+				void process(signal* output, int length) { render<&OSM::pulse>(output, length); }
+			};
+
+			/// Pulse wave oscillator (band-limited, optimised)
+			struct Pulse : public Osm<Pulse> {
+				Pulse() : Osm(&OSM::pulse, 0.5f) {}
+				void process() { out = osm.pulse(); }
+				void process(signal* output, int length) { render<&OSM::pulse>(output, length); }
+			};
+
+			/// White noise generator (optimised)
+			struct Noise : public Generator<Noise> {
+				Random prng; ///< per-object stream (seed for repeatable noise)
+
+				void process() {
+					out = prng.draw(-1.f, 1.f); // (same stream as the block fill)
+				}
+
+				void process(signal* output, int length) {
+					prng.bipolar((float*)output, length);
+				}
+			};
+		};
+
+		/// Transposed Direct Form II Biquadratic Filter (static dispatch)
+		namespace Biquad {
+
+			/// Filter base class (coefficients from DERIVED::init())
+			template<class DERIVED>
+			struct Filter : public Modifier<DERIVED> {
+				using Modifier<DERIVED>::in;
+				using Modifier<DERIVED>::out;
+
+				float f = 0; 	// cutoff/centre f
+				float Q = 0;	// Q (resonance)
+
+				float /*a0 = 1*/ a1 = 0, a2 = 0, b0 = 1, b1 = 0, b2 = 0; // coefficients
+
+				float a = 0;		// alpha
+				float cos0 = 1;		// cos(omega)
+				float sin0 = 0;		// sin(omega)
+				float z[2] = { 0 };	// filter state
+
+				/// Reset filter state
+				void reset() {
+					f = 0;
+					Q = 0;
+					b0 = 1;
+					a1 = a2 = b1 = b2 = 0;
+					a = 0;
+					z[0] = z[1] = 0;
+				}
+
+				/// Set the filter cutoff (default Q)
+				void set(param f) { this->derived().set(f, param(root2.inv)); }
+
+				/// Set the filter cutoff and bandwidth
+				void set(param f, relative bw) {
+					if (bw > 0)
+						this->derived().set(f, param(f / bw));
+				}
+
+				/// Set the filter cutoff and Q
+				void set(param f, param Q) {
+					if (Q < 0) // treat negative Q as bandwidth
+						Q = f / -Q;
+
+					if (Filter::f != f || Filter::Q != Q) {
+						Filter::f = f;
+						Filter::Q = Q;
+
+						const float w = f * fs.w;
+						cos0 = cosf(w);
+						sin0 = sinf(w);
+
+						if (Q < 0.5) Q = 0.5;
+						a = sin0 / (2.f * Q);
+						this->derived().init();
+					}
+				}
+
+				/// Apply the biquad filter (Transposed Direct Form II)
+				void process() noexcept {
+					const float z0 = z[0];
+					const float z1 = z[1];
+					const float y = b0 * in + z0;
+					z[0] = b1 * in - a1 * y + z1;
+					z[1] = b2 * in - a2 * y;
+					out = y;
+				}
+
+				/// Apply the biquad filter to a block of samples (Transposed Direct Form II)
+				void process(const signal* input, signal* output, int length) noexcept {
+					float z0 = z[0], z1 = z[1], x = in, y = out;
+					for (int s = 0; s < length; s++) {
+						x = input[s];
+						y = b0 * x + z0;
+						z0 = b1 * x - a1 * y + z1;
+						z1 = b2 * x - a2 * y;
+						output[s] = y;
+					}
+					z[0] = z0; z[1] = z1;
+					in = x; out = y;
+				}
+			};
+
+			/// Low-pass filter (LPF)
+			struct LPF : Filter<LPF> {
+				void init() {
+					constant a0 = { 1.f + a };
+					a1 = a0.inv * (-2.f * cos0);
+					a2 = a0.inv * (1.f - a);
+
+					b2 = b0 = a0.inv * (1.f - cos0) * 0.5f;
+					b1 = a0.inv * (1.f - cos0);
+				}
+			};
+
+			typedef LPF HCF; ///< High-cut filter (HCF)
+			typedef LPF HRF; ///< High-reject filter (HRF)
+
+			/// High-pass filter (HPF)
+			struct HPF : Filter<HPF> {
+				void init() {
+					constant a0 = { 1.f + a };
+					a1 = a0.inv * (-2.f * cos0);
+					a2 = a0.inv * (1.f - a);
+
+					b2 = b0 = a0.inv * (1.f + cos0) * 0.5f;
+					b1 = a0.inv * -(1.f + cos0);
+				}
+			};
+
+			typedef HPF LCF; ///< Low-cut filter (LCF)
+			typedef HPF LRF; ///< Low-reject filter (LRF)
+
+			/// Band-pass filter (BPF)
+			struct BPF : Filter<BPF> {
+				using Gain = Filters::Biquad::BPF::Gain;
+				static constexpr Gain ConstantSkirtGain = Filters::Biquad::BPF::ConstantSkirtGain;
+				static constexpr Gain ConstantPeakGain = Filters::Biquad::BPF::ConstantPeakGain;
+
+				/// Set the constant gain mode.
+				BPF& operator=(Gain gain) {
+					skirt = gain == ConstantSkirtGain;
+					init();
+					return *this;
+				}
+
+				bool skirt = false; ///< @internal
+
+				/// @internal
+				void init() {
+					constant a0 = { 1.f + a };
+					a1 = a0.inv * (-2.f * cos0);
+					a2 = a0.inv * (1.f - a);
+
+					b0 = a0.inv * (skirt ? sin0 * 0.5f : a); // constant skirt / peak gain
+					b1 = 0;
+					b2 = -b0;
+				}
+			};
+
+			/// Band-Reject Filter (BRF)
+			struct BRF : Filter<BRF> {
+				void init() {
+					constant a0 = { 1.f + a };
+					b1 = a1 = a0.inv * (-2.f * cos0);
+					a2 = a0.inv * (1.f - a);
+					b0 = b2 = a0.inv;
+				}
+			};
+
+			typedef BRF BSF; ///< Band-stop filter (BSF)
+
+			/// All-pass filter (APF)
+			struct APF : Filter<APF> {
+				/// Set the filter cutoff (default r)
+				void set(param f) { set(f, 1.f); }
+
+				/// Set the pole frequency and radius (r)
+				void set(param f, param r) {
+					if (Filter::f != f || a != r) {
+						Filter::f = f;
+						a = r;
+
+						const float w = f * fs.w;
+						cos0 = cosf(w);
+						sin0 = sinf(w);
+
+						init();
+					}
+				}
+
+				void init() {
+					b0 = a2 = a * a;
+					b1 = a1 = (-2.f * a * cos0);
+					b2 = 1.f;
+				}
+			};
+		};
+
+		using namespace Fast;
+		using namespace Biquad;
+	};
+
+
 	/// Envelope follower (Peak / RMS)
 	struct Envelope::Follower : Modifier {
 
@@ -4757,6 +8991,18 @@ namespace klang {
 				const float smoothing = in > out ? A : R;
 				(out + smoothing * (in - out)) >> out;
 			}
+
+			void process(const signal* input, signal* output, int length) {
+				const float a = A, r = R;
+				float y = out;
+				for (int s = 0; s < length; s++) {
+					const float x = input[s];
+					y += (x > y ? a : r) * (x - y);
+					output[s] = y;
+				}
+				if (length > 0) in = input[length - 1];
+				out = y;
+			}
 		} ar;
 
 		// Peak / RMS Envelope Follower (default; filter-based)
@@ -4824,10 +9070,519 @@ namespace klang {
 		};
 	};
 
+	/// @cond
+	/// Structure-of-arrays bank base (built-in primitives; lanes hold coefficients / state, items hold parameters)
+	template<typename TYPE, int COUNT, class BANK>
+	struct Lanes : public GeneratorOrModifier<TYPE, signals<COUNT>> {
+		TYPE items[COUNT]; // per-lane parameter objects (synced to lane arrays via load() / store())
+
+		/// Lane accessor (applies parameter changes to the lane's object, then syncs the lane at once)
+		struct Lane {
+			BANK& bank;
+			const int n;
+
+			template<typename... Args>
+			Lane& set(Args... args) { bank.load(n); bank.items[n].set(args...); bank.store(n); return *this; }
+
+			template<typename... Args>
+			Lane& operator()(Args... args) { return set(args...); }
+
+			template<typename VALUE>
+			Lane& operator=(const VALUE& value) { bank.load(n); bank.items[n] = value; bank.store(n); return *this; }
+		};
+
+		/// Lane's object (state loaded; changes are synced at the next process())
+		TYPE& operator[](int index) { bank().load(index); changed[index] = dirty = true; return items[index]; }
+		const TYPE& operator[](int index) const { return items[index]; }
+
+		Lane lane(int index) { return { bank(), index }; }
+
+		template<typename... Args>
+		void set(Args... args) {
+			for (int n = 0; n < COUNT; n++)
+				lane(n).set(args...);
+		}
+
+	protected:
+		bool dirty = false;					// any lane accessed via operator[] since the last sync
+		bool changed[COUNT] = { false };
+
+		BANK& bank() { return static_cast<BANK&>(*this); }
+
+		// store lanes accessed via operator[] (at the start of each process)
+		void sync() {
+			if (!dirty)
+				return;
+			for (int n = 0; n < COUNT; n++) {
+				if (changed[n])
+					bank().store(n);
+				changed[n] = false;
+			}
+			dirty = false;
+		}
+	};
+	/// @endcond
+
+	/// Parallel bank of biquad filters (structure-of-arrays; COUNT lanes per SIMD pass)
+	template<typename TYPE, int COUNT>
+	struct Bank<TYPE, COUNT, std::enable_if_t<std::is_base_of_v<Filters::Biquad::Filter, TYPE> && COUNT % 4 == 0>>
+		: public Lanes<TYPE, COUNT, Bank<TYPE, COUNT>> {
+		using Lanes<TYPE, COUNT, Bank>::items;
+		using Lanes<TYPE, COUNT, Bank>::in;
+		using Lanes<TYPE, COUNT, Bank>::out;
+
+		alignas(simd::align<COUNT>()) float b0[COUNT], b1[COUNT], b2[COUNT], a1[COUNT], a2[COUNT]; // coefficients
+		alignas(simd::align<COUNT>()) float z0[COUNT], z1[COUNT]; // filter state
+
+		Bank() { for (int n = 0; n < COUNT; n++) store(n); }
+
+		void load(int n) { items[n].z[0] = z0[n]; items[n].z[1] = z1[n]; items[n].out = out[n]; }
+		void store(int n) {
+			b0[n] = items[n].b0; b1[n] = items[n].b1; b2[n] = items[n].b2;
+			a1[n] = items[n].a1; a2[n] = items[n].a2;
+			z0[n] = items[n].z[0]; z1[n] = items[n].z[1];
+		}
+
+		void input() override {}
+
+		void process() override {
+			this->sync();
+			using V = simd::vector<COUNT>;
+			for (int i = 0; i < COUNT; i += V::width) {
+				const V x = V::load(in.data() + i);
+				const V y = V::load(b0 + i) * x + V::load(z0 + i);
+				(V::load(b1 + i) * x - V::load(a1 + i) * y + V::load(z1 + i)).store(z0 + i);
+				(V::load(b2 + i) * x - V::load(a2 + i) * y).store(z1 + i);
+				y.store(out.data() + i);
+			}
+		}
+	};
+
+	/// Parallel bank of one-pole filters (structure-of-arrays; COUNT lanes per SIMD pass)
+	template<typename TYPE, int COUNT>
+	struct Bank<TYPE, COUNT, std::enable_if_t<(std::is_base_of_v<Filters::OnePole::LPF, TYPE> || std::is_base_of_v<Filters::OnePole::HPF, TYPE>) && COUNT % 4 == 0>>
+		: public Lanes<TYPE, COUNT, Bank<TYPE, COUNT>> {
+		using Lanes<TYPE, COUNT, Bank>::items;
+		using Lanes<TYPE, COUNT, Bank>::in;
+		using Lanes<TYPE, COUNT, Bank>::out;
+
+		alignas(simd::align<COUNT>()) float b0[COUNT], b1[COUNT], a1[COUNT]; // coefficients
+		alignas(simd::align<COUNT>()) float z[COUNT]; // filter state
+
+		Bank() { for (int n = 0; n < COUNT; n++) store(n); }
+
+		void load(int n) { items[n].z = z[n]; items[n].out = out[n]; }
+		void store(int n) {
+			b0[n] = items[n].b0; b1[n] = items[n].b1; a1[n] = items[n].a1;
+			z[n] = items[n].z; out[n] = items[n].out;
+		}
+
+		void input() override {}
+
+		void process() override {
+			this->sync();
+			using V = simd::vector<COUNT>;
+			for (int i = 0; i < COUNT; i += V::width) {
+				const V x = V::load(in.data() + i);
+				(V::load(b0 + i) * x + V::load(b1 + i) * V::load(z + i) + V::load(a1 + i) * V::load(out.data() + i)).store(out.data() + i);
+				x.store(z + i);
+			}
+		}
+	};
+
+	/// Parallel bank of sine oscillators (structure-of-arrays; integer phase per lane)
+	template<typename TYPE, int COUNT>
+	struct Bank<TYPE, COUNT, std::enable_if_t<std::is_base_of_v<Generators::Fast::Sine, TYPE> && COUNT % 4 == 0>>
+		: public Lanes<TYPE, COUNT, Bank<TYPE, COUNT>> {
+		using Lanes<TYPE, COUNT, Bank>::items;
+		using Lanes<TYPE, COUNT, Bank>::out;
+
+		using Lanes<TYPE, COUNT, Bank>::process;
+
+		alignas(simd::align<COUNT>()) unsigned int position[COUNT], offset[COUNT];
+		alignas(simd::align<COUNT>()) signed int increment[COUNT];
+
+		Bank() { for (int n = 0; n < COUNT; n++) store(n); }
+
+		void load(int n) { items[n].position.position = position[n]; items[n].out = out[n]; }
+		void store(int n) {
+			position[n] = items[n].position.position;
+			offset[n] = items[n].offset.position;
+			increment[n] = items[n].increment.amount;
+		}
+
+		void process() override {
+			this->sync();
+			alignas(simd::align<COUNT>()) unsigned int phase[COUNT];
+			for (int n = 0; n < COUNT; n++) {
+				phase[n] = position[n] + offset[n];
+				position[n] += increment[n];
+			}
+			Generators::Fast::fastsinp(phase, out.data(), COUNT);
+		}
+
+		/// Advance all lanes with per-lane phase modulation (radians, e.g. for FM)
+		void process(const float* modulation) {
+			this->sync();
+			constexpr float turns = float(1.0 / (2.0 * 3.1415926535897932384626433832795));
+			alignas(simd::align<COUNT>()) unsigned int phase[COUNT];
+			for (int n = 0; n < COUNT; n++) {
+				float t = modulation[n] * turns;
+				t -= floorf(t + 0.5f); // [-0.5, 0.5) turns
+				phase[n] = position[n] + offset[n] + (unsigned int)(int)(t * 4294967296.f);
+				position[n] += increment[n];
+			}
+			Generators::Fast::fastsinp(phase, out.data(), COUNT);
+		}
+	};
+
+	/// Parallel bank of band-limited oscillators (structure-of-arrays; built-in Fast::Saw, Triangle, Square and Pulse)
+	/// Lanes step their phase state machines together; the rare edge samples are then corrected per lane.
+	template<typename TYPE, int COUNT>
+	struct Bank<TYPE, COUNT, std::enable_if_t<(std::is_same_v<TYPE, Generators::Fast::Saw> || std::is_same_v<TYPE, Generators::Fast::Triangle>
+		|| std::is_same_v<TYPE, Generators::Fast::Square> || std::is_same_v<TYPE, Generators::Fast::Pulse>) && COUNT % 4 == 0>>
+		: public Lanes<TYPE, COUNT, Bank<TYPE, COUNT>> {
+		using Lanes<TYPE, COUNT, Bank>::items;
+		using Lanes<TYPE, COUNT, Bank>::out;
+		typedef Generators::Fast::OSM OSM;
+
+		static constexpr bool pulse = std::is_same_v<TYPE, Generators::Fast::Square> || std::is_same_v<TYPE, Generators::Fast::Pulse>;
+
+		alignas(simd::align<COUNT>()) unsigned int offset[COUNT], duty[COUNT], state[COUNT];	// phase state
+		alignas(simd::align<COUNT>()) signed int increment[COUNT];
+		alignas(simd::align<COUNT>()) float f[COUNT], col[COUNT], c1[COUNT], c2[COUNT];	// coefficients
+
+		Bank() { for (int n = 0; n < COUNT; n++) store(n); }
+
+		void load(int n) { items[n].osm.offset.position = offset[n]; items[n].osm.state = (OSM::State)state[n]; items[n].out = out[n]; }
+		void store(int n) {
+			const OSM& osm = items[n].osm;
+			offset[n] = osm.offset.position; duty[n] = osm.duty.position; state[n] = osm.state;
+			increment[n] = osm.increment.amount;
+			f[n] = osm.f; col[n] = osm.col; c1[n] = osm.c1; c2[n] = osm.c2;
+		}
+
+		void process() override {
+			this->sync();
+			using Generators::Fast::choose;
+			alignas(simd::align<COUNT>()) float phase[COUNT];
+			alignas(simd::align<COUNT>()) unsigned int edge[COUNT];
+			for (int n = 0; n < COUNT; n++) {
+				// as OSM::tick(), with the phase (in [0, 1)) before the tick
+				const unsigned int position = offset[n];
+				const unsigned int bits = (position >> 9) | 0x3F800000u;
+				float p;
+				memcpy(&p, &bits, sizeof(float));
+				p -= 1.f;
+				const unsigned int now = ((state[n] << 1) | (unsigned int)(position < duty[n])) & (OSM::NewUp | OSM::OldUp);
+				const unsigned int carry = position < (unsigned int)increment[n] ? (unsigned int)OSM::DownUpDown : 0u;
+				state[n] = now;
+				offset[n] = position + increment[n];
+				edge[n] = now | carry;
+				phase[n] = p;
+
+				// steady segments (Up / Down)
+				if constexpr (pulse) {
+					out[n] = choose(now == OSM::Up, 1.f, -1.f);
+				} else {
+					const float q = p - col[n];
+					out[n] = choose(now == OSM::Up, c1[n], c2[n]) * (q + q - f[n]) + 1.f;
+				}
+			}
+			for (int n = 0; n < COUNT; n++) {
+				if (edge[n] != OSM::Up && edge[n] != OSM::Down) { // crossed the duty point or wrapped (rare)
+					const OSM& osm = items[n].osm;
+					out[n] = pulse ? osm.pulse(phase[n], (OSM::State)edge[n]) : osm.saw(phase[n] - col[n], (OSM::State)edge[n]);
+				}
+			}
+		}
+	};
+
+	/// Parallel bank of attack / release followers (structure-of-arrays)
+	template<typename TYPE, int COUNT>
+	struct Bank<TYPE, COUNT, std::enable_if_t<std::is_base_of_v<Envelope::Follower::AR, TYPE> && COUNT % 4 == 0>>
+		: public Lanes<TYPE, COUNT, Bank<TYPE, COUNT>> {
+		using Lanes<TYPE, COUNT, Bank>::items;
+		using Lanes<TYPE, COUNT, Bank>::in;
+		using Lanes<TYPE, COUNT, Bank>::out;
+
+		alignas(simd::align<COUNT>()) float A[COUNT], R[COUNT]; // attack / release coefficients
+
+		Bank() { for (int n = 0; n < COUNT; n++) store(n); }
+
+		void load(int n) { items[n].out = out[n]; }
+		void store(int n) { A[n] = items[n].A; R[n] = items[n].R; out[n] = items[n].out; }
+
+		void input() override {}
+
+		void process() override {
+			this->sync();
+			float* const y = out.data();
+			const float* const x = in.data();
+			for (int n = 0; n < COUNT; n++)
+				y[n] += (x[n] > y[n] ? A[n] : R[n]) * (x[n] - y[n]);
+		}
+	};
+
+	/// Parallel bank of delays (structure-of-arrays; interleaved frames, shared write position)
+	template<int SIZE, int COUNT>
+	struct Bank<Delay<SIZE>, COUNT, std::enable_if_t<SIZE != 0 && COUNT % 4 == 0>> : public Generic::Modifier<signals<COUNT>> {
+		using Generic::Modifier<signals<COUNT>>::in;
+		using Generic::Modifier<signals<COUNT>>::out;
+
+		buffer buffer;					// SIZE frames of COUNT samples
+		int position = 0;				// write frame
+		float time[COUNT];				// delay (in samples)
+		int read[COUNT] = { 0 };		// read frame
+		float fraction[COUNT] = { 0 };	// read interpolation
+
+		Bank() : buffer(SIZE * COUNT, 0) { for (int n = 0; n < COUNT; n++) set(n, 1); }
+
+		void clear() { buffer.clear(); }
+
+		/// Lane accessor
+		struct Lane {
+			Bank& bank;
+			const int n;
+			Lane& set(param samples) { bank.set(n, samples); return *this; }
+			Lane& operator()(param samples) { return set(samples); }
+		};
+
+		Lane operator[](int index) { return { *this, index }; }
+
+		/// Set the delay (in samples) of all lanes
+		void set(param samples) {
+			for (int n = 0; n < COUNT; n++)
+				set(n, samples);
+		}
+
+		/// Set the delay (in samples) of a single lane (as Delay::tap(), from the next input)
+		void set(int n, param samples) {
+			time[n] = std::clamp((float)samples, 0.f, (float)(SIZE - 1));
+
+			// read frame relative to the position after the next write
+			float from = static_cast<float>(position) - time[n];
+			while (from < 0.f)
+				from += SIZE;
+
+			read[n] = static_cast<int>(floorf(from));
+			if (read[n] >= SIZE)
+				read[n] -= SIZE;
+			fraction[n] = from - floorf(from);
+		}
+
+		void input() override {
+			float* const frame = buffer.data() + position * COUNT;
+			for (int n = 0; n < COUNT; n++)
+				frame[n] = in[n];
+			if (++position == SIZE)
+				position = 0;
+		}
+
+		void process() override {
+			const float* const samples = buffer.data();
+			for (int n = 0; n < COUNT; n++) {
+				const int next = (read[n] + 1 == SIZE) ? 0 : (read[n] + 1);
+				const float a = samples[read[n] * COUNT + n];
+				const float b = samples[next * COUNT + n];
+				out[n] = a + fraction[n] * (b - a);
+				read[n] = next;
+			}
+		}
+
+		unsigned int max() const { return SIZE; }
+	};
+
+	struct File {
+#if defined(_MSC_VER)
+#define packed __pragma(pack(push,1)) struct __pragma(pack(pop))
+#else
+#define packed struct __attribute__((packed))
+#endif
+		struct Format {
+			unsigned int channels = 0;
+			unsigned int samplerate = 0;
+			unsigned int bitrate = 0;
+		};
+
+		packed Chunk{
+			struct ID {
+				char id[4] = { 0 };
+				ID() = default;
+				ID(const char* id) : id{ id[0], id[1], id[2], id[3] } {}
+				bool operator==(const ID& id) const {
+					return memcmp(ID::id, id.id, 4) == 0;
+				}
+				bool operator==(const char* const id) const {
+					return memcmp(ID::id, id, 4) == 0;
+				}
+			} id;
+			unsigned int size = 0;
+
+			Chunk() = default;
+			Chunk(ID id, unsigned int size = 0) : id(id), size(size) {}
+		};
+
+		packed Header : Chunk{
+			ID format;
+
+			Header() = default;
+			Header(ID id, ID format, unsigned int size = 0) : Chunk(id, size), format(format) {}
+
+			bool isWAV()  const { return id == "RIFF" && format == "WAVE"; }
+			bool isAIFF() const { return id == "FORM" && format == "AIFF"; }
+		};
+
+		packed WAV{
+			Memory memory;
+
+			packed Header : File::Header {
+				Header() : File::Header("RIFF", "WAVE") {}
+			} *header = nullptr;
+
+			packed Format : Chunk {
+				unsigned short AudioFormat;
+				unsigned short NumChannels;
+				unsigned int   SampleRate;
+				unsigned int   ByteRate;
+				unsigned short BlockAlign;
+				unsigned short BitsPerSample;
+
+				Format() : Chunk("fmt ", sizeof(Format)) {}
+
+				operator File::Format() const { return { NumChannels, SampleRate, BitsPerSample }; }
+			} *format = nullptr;
+
+			packed Data : Chunk {
+				unsigned char data[1] = { 0 };
+
+				Data() : Chunk("data") {}
+			} *data = nullptr;
+
+			// use internal memory
+			bool load(const char* path) {
+				memory.load(path);
+				return load();
+			}
+
+			// use external memory
+			bool load(Memory& memory) {
+				WAV::memory = &memory;
+				return load();
+			}
+
+			bool load() {
+				if (!memory.ptr)
+					return false;
+				memory.rewind();
+
+				// header
+				header = (Header*)memory.ptr;
+				if (!header->isWAV())
+					return false;
+				memory.skip(sizeof(Header));
+
+				// other chunks
+				while (!memory.finished()) {
+					const Chunk chunk = memory;
+					memory.rewind(sizeof(Chunk));
+					if (chunk.id == "fmt ")
+						format = (Format*)memory.ptr;
+					else if (chunk.id == "data") {
+						if (memory.ptr + chunk.size > memory.end)
+							return false; // corrupt
+						data = (Data*)memory.ptr;
+					}
+					memory.skip(sizeof(Chunk) + chunk.size);
+				}
+				return true;
+			}
+
+			template<typename TYPE, int STEP = 1>
+			inline static void decode(float* buffer, const TYPE* data, int length) {
+				if constexpr (std::is_floating_point<TYPE>::value) {
+					while (length--) {
+						*buffer++ = *data; 
+						data += STEP;
+					}
+				} else {
+					constexpr unsigned int twoComp = 1U << (sizeof(TYPE) * 8 - 1);
+					if constexpr (std::numeric_limits<TYPE>::is_signed) {
+						constexpr float scale = 1.f / twoComp;
+						while (length--) {
+							*buffer++ = static_cast<float>(*data) * scale; 
+							data += STEP;
+						}
+					} else {
+						constexpr float scale = 1.f / ((twoComp << 1) - 1);
+						while (length--) {
+							*buffer++ = (static_cast<float>(*data) - twoComp) * scale; 
+							data += STEP;
+						}
+					}
+				}
+			}
+
+			bool operator>>(variable::buffer& buffer) {
+				if (!header || !format || !data) 
+					return false;
+
+				buffer.resize(data->size / format->BlockAlign);
+				if (format->AudioFormat == 1) {	// PCM (integer)
+					if (format->BitsPerSample == 8)
+						decode<unsigned char>(buffer.data(), (unsigned char*)data->data, buffer.size); // 8-bit (unsigned)
+					else if(format->BitsPerSample == 16)
+						decode<signed short>(buffer.data(), (signed short*)data->data, buffer.size); // 16-bit (signed)
+					else if(format->BitsPerSample == 32)
+						decode<signed int>(buffer.data(), (signed int*)data->data, buffer.size); // 32-bit (signed)
+				} else if (format->AudioFormat == 3) { 
+					if(format->BitsPerSample == 32)
+						decode<float>(buffer.data(), (float*)data->data, buffer.size); // 32-bit (float)
+				}
+				return true;
+			}
+		};
+
+		//struct AIFF {		
+		//	struct Binary Extended {
+		//		unsigned short exponent;	  // 15-bit exponent + sign bit
+		//		unsigned long long mantissa;  // 64-bit mantissa
+		//
+		//		operator double() const {
+		//			uint16_t exp = (exponent >> 8) | (exponent << 8); // Swap bytes (big-endian to host)
+		//			const bool sign = exp & 0x8000;		// Extract sign bit
+		//			exp &= 0x7FFF;						// Remove sign bit
+		//
+		//			uint64_t mant = __builtin_bswap64(mantissa); // Convert mantissa (big-endian to host)
+		//			if (exp == 0 && mant == 0) return 0.0; // Handle zero case
+		//
+		//			double fraction = static_cast<double>(mant) / (1ULL << 63); // normalize mantissa (hidden bit)
+		//			return (sign ? -fraction : fraction) * std::pow(2.0, exp - 16383);
+		//		}
+		//	};
+		//
+		//	struct Binary Header : File::Header {
+		//		Header() : File::Header("FORM", "AIFF") {}
+		//	};
+		//
+		//	struct Binary Format : Chunk {
+		//		unsigned short numChannels;
+		//		unsigned int   numSamplesFrames;
+		//		unsigned short sampleSize;
+		//		Extended	   sampleRate;
+		//
+		//		Format() : Chunk("COMM ", sizeof(Format)) { }
+		//
+		//		operator File::Format() const { return { numChannels, sampleRate, sampleSize }; }
+		//	};
+		//};
+	};
+
 	namespace basic {
 		using namespace klang;
 
 		using namespace Generators::Basic;
+		using namespace Modifiers;
 		using namespace Filters;
 		using namespace Filters::Biquad;
 	};
@@ -4836,6 +9591,7 @@ namespace klang {
 		using namespace klang;
 
 		using namespace Generators::Fast;
+		using namespace Modifiers;
 		using namespace Filters;
 		using namespace Filters::Biquad;
 	};
@@ -4844,7 +9600,45 @@ namespace klang {
 		using namespace klang;
 	};
 
+	/// Optimised objects with static dispatch (opt-in; e.g. for hot notes)
+	namespace inlined {
+		using namespace klang;
+
+		using namespace Static::Fast;
+		using namespace Modifiers;
+		using namespace Filters;
+		using namespace Static::Biquad;
+	};
+
 	//using namespace optimised;
 };
 
+#ifdef KLANG_TRAP_ALLOCATIONS
+// allocation trap (debug): define KLANG_TRAP_ALLOCATIONS in one translation unit only
+void* operator new(std::size_t size) { klang::Realtime::allocated(); if (void* p = malloc(size ? size : 1)) return p; throw std::bad_alloc(); }
+void* operator new[](std::size_t size) { klang::Realtime::allocated(); if (void* p = malloc(size ? size : 1)) return p; throw std::bad_alloc(); }
+void operator delete(void* p) noexcept { if (p) klang::Realtime::allocated(); free(p); }
+void operator delete[](void* p) noexcept { if (p) klang::Realtime::allocated(); free(p); }
+void operator delete(void* p, std::size_t) noexcept { if (p) klang::Realtime::allocated(); free(p); }
+void operator delete[](void* p, std::size_t) noexcept { if (p) klang::Realtime::allocated(); free(p); }
+// over-aligned (e.g. klang::Pool); the original block is stored just before the aligned pointer
+static void* klang_aligned_new(std::size_t size, std::align_val_t align) {
+	klang::Realtime::allocated();
+	const std::size_t alignment = (std::size_t)align < sizeof(void*) ? sizeof(void*) : (std::size_t)align;
+	if (void* p = malloc(size + alignment + sizeof(void*))) {
+		void** aligned = (void**)(((std::uintptr_t)p + sizeof(void*) + alignment - 1) & ~(std::uintptr_t)(alignment - 1));
+		aligned[-1] = p;
+		return aligned;
+	}
+	throw std::bad_alloc();
+}
+static void klang_aligned_delete(void* p) noexcept { if (p) { klang::Realtime::allocated(); free(((void**)p)[-1]); } }
+void* operator new(std::size_t size, std::align_val_t align) { return klang_aligned_new(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return klang_aligned_new(size, align); }
+void operator delete(void* p, std::align_val_t) noexcept { klang_aligned_delete(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { klang_aligned_delete(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { klang_aligned_delete(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { klang_aligned_delete(p); }
+#endif
+
 //using namespace klang;
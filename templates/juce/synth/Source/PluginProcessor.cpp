@@ -84,7 +84,8 @@ bool KlangSynthAudioProcessor::isMidiEffect() const
 
 double KlangSynthAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // KLANG : report the plugin's tail (e.g. declared, or measured by its silence detector)
+    return subtractive.tail();
 }
 
 int KlangSynthAudioProcessor::getNumPrograms()
@@ -114,8 +115,8 @@ void KlangSynthAudioProcessor::changeProgramName (int index, const juce::String&
 //==============================================================================
 void KlangSynthAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
+    // KLANG : set the sample rate and maximum block size (before playback; allocates)
+    subtractive.configure((float)sampleRate, samplesPerBlock);
 }
 
 void KlangSynthAudioProcessor::releaseResources()
@@ -165,16 +166,17 @@ void KlangSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    // KLANG : pass MIDI to synth
+    // KLANG : queue MIDI for the synth (applied at each message's sample offset)
     for (const auto& message : midiMessages)
-        subtractive.input(message.data[0], message.data[1], message.data[2]);
+        if (message.numBytes >= 2)
+            subtractive.events.midi(message.samplePosition, message.data[0], message.data[1], message.numBytes > 2 ? message.data[2] : 0);
 
     // KLANG : copy parameters to synth
     for (unsigned int c = 0; c < subtractive.controls.size(); c++)
         subtractive.controls[c].setNormalised(getParameters()[c]->getValue());
 
     // KLANG : generate + process audio
-    subtractive.output((float**)buffer.getArrayOfWritePointers(), buffer.getNumSamples());
+    subtractive.process((float**)buffer.getArrayOfWritePointers(), buffer.getNumSamples());
 
     // KLANG : copy parameters from synth (may have changed during process)
     for (unsigned int c = 0; c < subtractive.controls.size(); c++)